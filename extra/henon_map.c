@@ -68,6 +68,9 @@ int main (int argc, char *argv[])
     arpra_increase(&y, &y, uncertainty);
     mpfr_set_d(rt, rel_threshold, MPFR_RNDN);
 
+    // Only reduce rounding and approximation terms
+    arpra_set_reduce_classes((1 << ARPRA_SYMBOL_ROUNDING) | (1 << ARPRA_SYMBOL_APPROXIMATION));
+
     // Open output files
     x_out = fopen("henon_x.dat", "w");
     y_out = fopen("henon_y.dat", "w");
@@ -73,6 +73,8 @@
 #define p_report_step 20
 #define p_reduce_step 100
 #define p_reduce_rel 0.1
+#define p_threads threads_arg
+arpra_uint threads_arg = 1;
 
 // RNG parameters
 // Seeds are random if not #defined
@@ -191,182 +193,142 @@ void file_write (const arpra_range *A, arpra_uint grp_size,
     }
 }
 
-struct dMdt_params
+struct dMHNdt_params
 {
+    arpra_uint grp_H;
+    arpra_uint grp_N;
     arpra_uint grp_V;
+    arpra_uint size;
     arpra_range *pos_1;
     arpra_range *pos_4;
     arpra_range *pos_5;
+    arpra_range *pos_18;
     arpra_range *pos_25;
+    arpra_range *pos_40;
+    arpra_range *neg_48;
+    arpra_range *neg_50;
     arpra_range *neg_52;
+    arpra_range *neg_55;
     arpra_range *pos_028;
     arpra_range *pos_032;
-    arpra_range *temp1;
-    arpra_range *temp2;
-    arpra_range *_a;
-    arpra_range *_b;
-};
-
-void dMdt (arpra_range *y, const void *params,
-           const arpra_range *t, const arpra_range **x,
-           const arpra_uint x_grp, const arpra_uint x_dim)
-{
-    const struct dMdt_params *p = (struct dMdt_params *) params;
-    const arpra_range *M = &(x[x_grp][x_dim]);
-    const arpra_range *V = &(x[p->grp_V][x_dim]);
-    const arpra_range *pos_1 = p->pos_1;
-    const arpra_range *pos_4 = p->pos_4;
-    const arpra_range *pos_5 = p->pos_5;
-    const arpra_range *pos_25 = p->pos_25;
-    const arpra_range *neg_52 = p->neg_52;
-    const arpra_range *pos_028 = p->pos_028;
-    const arpra_range *pos_032 = p->pos_032;
-    arpra_range *temp1 = p->temp1;
-    arpra_range *temp2 = p->temp2;
-    arpra_range *_a = p->_a;
-    arpra_range *_b = p->_b;
-
-    // Compute M_a
-    // M_a = 0.32 * (-52.0 - V) / (exp((-52.0 - V) / 4.0) - 1.0)
-    arpra_sub(temp1, neg_52, V);
-    arpra_div(_a, temp1, pos_4);
-    arpra_exp(_a, _a);
-    arpra_sub(_a, _a, pos_1);
-    arpra_div(_a, temp1, _a);
-    arpra_mul(_a, pos_032, _a);
-
-    // Compute M_b
-    // M_b = 0.28 * (V + 25.0) / (exp((V + 25.0) / 5.0) - 1.0)
-    arpra_add(temp2, V, pos_25);
-    arpra_div(_b, temp2, pos_5);
-    arpra_exp(_b, _b);
-    arpra_sub(_b, _b, pos_1);
-    arpra_div(_b, temp2, _b);
-    arpra_mul(_b, pos_028, _b);
-
-    // delta of M
-    // dM/dt = (M_a * (1.0 - M) - M_b * M)
-    arpra_sub(temp1, pos_1, M);
-    arpra_mul(temp1, _a, temp1);
-    arpra_mul(temp2, _b, M);
-    arpra_sub(y, temp1, temp2);
-}
-
-struct dHdt_params
-{
-    arpra_uint grp_V;
-    arpra_range *pos_1;
-    arpra_range *pos_4;
-    arpra_range *pos_5;
-    arpra_range *pos_18;
-    arpra_range *neg_25;
-    arpra_range *neg_48;
     arpra_range *pos_0128;
-    arpra_range *temp1;
-    arpra_range *temp2;
-    arpra_range *_a;
-    arpra_range *_b;
-};
-
-void dHdt (arpra_range *y, const void *params,
-           const arpra_range *t, const arpra_range **x,
-           const arpra_uint x_grp, const arpra_uint x_dim)
-{
-    const struct dHdt_params *p = (struct dHdt_params *) params;
-    const arpra_range *H = &(x[x_grp][x_dim]);
-    const arpra_range *V = &(x[p->grp_V][x_dim]);
-    const arpra_range *pos_1 = p->pos_1;
-    const arpra_range *pos_4 = p->pos_4;
-    const arpra_range *pos_5 = p->pos_5;
-    const arpra_range *pos_18 = p->pos_18;
-    const arpra_range *neg_25 = p->neg_25;
-    const arpra_range *neg_48 = p->neg_48;
-    const arpra_range *pos_0128 = p->pos_0128;
-    arpra_range *temp1 = p->temp1;
-    arpra_range *temp2 = p->temp2;
-    arpra_range *_a = p->_a;
-    arpra_range *_b = p->_b;
-
-    // Compute H_a
-    // H_a = 0.128 * exp((-48.0 - V) / 18.0)
-    arpra_sub(_a, neg_48, V);
-    arpra_div(_a, _a, pos_18);
-    arpra_exp(_a, _a);
-    arpra_mul(_a, pos_0128, _a);
-
-    // Compute H_b
-    // H_b = 4.0 / (exp((-25.0 - V) / 5.0) + 1.0)
-    arpra_sub(_b, neg_25, V);
-    arpra_div(_b, _b, pos_5);
-    arpra_exp(_b, _b);
-    arpra_add(_b, _b, pos_1);
-    arpra_div(_b, pos_4, _b);
-
-    // delta of H
-    // dH/dt = (H_a * (1.0 - H) - H_b * H)
-    arpra_sub(temp1, pos_1, H);
-    arpra_mul(temp1, _a, temp1);
-    arpra_mul(temp2, _b, H);
-    arpra_sub(y, temp1, temp2);
-}
-
-struct dNdt_params
-{
-    arpra_uint grp_V;
-    arpra_range *pos_1;
-    arpra_range *pos_5;
-    arpra_range *pos_40;
-    arpra_range *neg_50;
-    arpra_range *neg_55;
     arpra_range *pos_0032;
     arpra_range *pos_05;
     arpra_range *temp1;
     arpra_range *temp2;
+    arpra_range *temp3;
     arpra_range *_a;
     arpra_range *_b;
 };
 
-void dNdt (arpra_range *y, const void *params,
-           const arpra_range *t, const arpra_range **x,
-           const arpra_uint x_grp, const arpra_uint x_dim)
+// Gating variables M, H and N of every neuron, computed jointly since they
+// all depend on V, and M_b and H_b share V + 25.0.
+void dMHNdt (arpra_range **y, const void *params,
+             const arpra_range *t, const arpra_range **x,
+             const arpra_uint x_grp)
 {
-    const struct dNdt_params *p = (struct dNdt_params *) params;
-    const arpra_range *N = &(x[x_grp][x_dim]);
-    const arpra_range *V = &(x[p->grp_V][x_dim]);
+    const struct dMHNdt_params *p = (struct dMHNdt_params *) params;
     const arpra_range *pos_1 = p->pos_1;
+    const arpra_range *pos_4 = p->pos_4;
     const arpra_range *pos_5 = p->pos_5;
+    const arpra_range *pos_18 = p->pos_18;
+    const arpra_range *pos_25 = p->pos_25;
     const arpra_range *pos_40 = p->pos_40;
+    const arpra_range *neg_48 = p->neg_48;
     const arpra_range *neg_50 = p->neg_50;
+    const arpra_range *neg_52 = p->neg_52;
     const arpra_range *neg_55 = p->neg_55;
+    const arpra_range *pos_028 = p->pos_028;
+    const arpra_range *pos_032 = p->pos_032;
+    const arpra_range *pos_0128 = p->pos_0128;
     const arpra_range *pos_0032 = p->pos_0032;
     const arpra_range *pos_05 = p->pos_05;
     arpra_range *temp1 = p->temp1;
     arpra_range *temp2 = p->temp2;
+    arpra_range *temp3 = p->temp3;
     arpra_range *_a = p->_a;
     arpra_range *_b = p->_b;
+    const arpra_range *M, *H, *N, *V;
+    arpra_uint i;
 
-    // Compute N_a
-    // N_a = 0.032 * (-50.0 - V) / (exp((-50.0 - V) / 5.0) - 1.0)
-    arpra_sub(temp1, neg_50, V);
-    arpra_div(_a, temp1, pos_5);
-    arpra_exp(_a, _a);
-    arpra_sub(_a, _a, pos_1);
-    arpra_div(_a, temp1, _a);
-    arpra_mul(_a, pos_0032, _a);
-
-    // Compute N_b
-    // N_b = 0.5 * exp((-55.0 - V) / 40.0)
-    arpra_sub(_b, neg_55, V);
-    arpra_div(_b, _b, pos_40);
-    arpra_exp(_b, _b);
-    arpra_mul(_b, pos_05, _b);
-
-    // delta of N
-    // dH/dt = (N_a * (1.0 - N) - N_b * N)
-    arpra_sub(temp1, pos_1, N);
-    arpra_mul(temp1, _a, temp1);
-    arpra_mul(temp2, _b, N);
-    arpra_sub(y, temp1, temp2);
+    for (i = 0; i < p->size; i++) {
+        M = &(x[x_grp][i]);
+        H = &(x[p->grp_H][i]);
+        N = &(x[p->grp_N][i]);
+        V = &(x[p->grp_V][i]);
+
+        // Shared by M_b and H_b
+        arpra_add(temp3, V, pos_25);
+
+        // Compute M_a
+        // M_a = 0.32 * (-52.0 - V) / (exp((-52.0 - V) / 4.0) - 1.0)
+        arpra_sub(temp1, neg_52, V);
+        arpra_div(_a, temp1, pos_4);
+        arpra_exp(_a, _a);
+        arpra_sub(_a, _a, pos_1);
+        arpra_div(_a, temp1, _a);
+        arpra_mul(_a, pos_032, _a);
+
+        // Compute M_b
+        // M_b = 0.28 * (V + 25.0) / (exp((V + 25.0) / 5.0) - 1.0)
+        arpra_div(_b, temp3, pos_5);
+        arpra_exp(_b, _b);
+        arpra_sub(_b, _b, pos_1);
+        arpra_div(_b, temp3, _b);
+        arpra_mul(_b, pos_028, _b);
+
+        // delta of M
+        // dM/dt = (M_a * (1.0 - M) - M_b * M)
+        arpra_sub(temp1, pos_1, M);
+        arpra_mul(temp1, _a, temp1);
+        arpra_mul(temp2, _b, M);
+        arpra_sub(&(y[x_grp][i]), temp1, temp2);
+
+        // Compute H_a
+        // H_a = 0.128 * exp((-48.0 - V) / 18.0)
+        arpra_sub(_a, neg_48, V);
+        arpra_div(_a, _a, pos_18);
+        arpra_exp(_a, _a);
+        arpra_mul(_a, pos_0128, _a);
+
+        // Compute H_b
+        // H_b = 4.0 / (exp((-25.0 - V) / 5.0) + 1.0)
+        arpra_neg(_b, temp3);
+        arpra_div(_b, _b, pos_5);
+        arpra_exp(_b, _b);
+        arpra_add(_b, _b, pos_1);
+        arpra_div(_b, pos_4, _b);
+
+        // delta of H
+        // dH/dt = (H_a * (1.0 - H) - H_b * H)
+        arpra_sub(temp1, pos_1, H);
+        arpra_mul(temp1, _a, temp1);
+        arpra_mul(temp2, _b, H);
+        arpra_sub(&(y[p->grp_H][i]), temp1, temp2);
+
+        // Compute N_a
+        // N_a = 0.032 * (-50.0 - V) / (exp((-50.0 - V) / 5.0) - 1.0)
+        arpra_sub(temp1, neg_50, V);
+        arpra_div(_a, temp1, pos_5);
+        arpra_exp(_a, _a);
+        arpra_sub(_a, _a, pos_1);
+        arpra_div(_a, temp1, _a);
+        arpra_mul(_a, pos_0032, _a);
+
+        // Compute N_b
+        // N_b = 0.5 * exp((-55.0 - V) / 40.0)
+        arpra_sub(_b, neg_55, V);
+        arpra_div(_b, _b, pos_40);
+        arpra_exp(_b, _b);
+        arpra_mul(_b, pos_05, _b);
+
+        // delta of N
+        // dN/dt = (N_a * (1.0 - N) - N_b * N)
+        arpra_sub(temp1, pos_1, N);
+        arpra_mul(temp1, _a, temp1);
+        arpra_mul(temp2, _b, N);
+        arpra_sub(&(y[p->grp_N][i]), temp1, temp2);
+    }
 }
 
 struct dVdt_params
@@ -464,43 +426,58 @@ struct dRdt_params
     arpra_range *threshold;
     int *in;
     arpra_uint pre_syn_size;
+    arpra_uint size;
     arpra_range *pos_1;
+    arpra_range *Q_lo;
+    arpra_range *Q_hi;
     arpra_range *temp1;
-    arpra_range *temp2;
 };
 
-void dRdt (arpra_range *y, const void *params,
+// Presynaptic potentials are either VPre_lo or VPre_hi, so the release
+// rise a Q is computed once for each, and shared by all synapses.
+void dRdt (arpra_range **y, const void *params,
            const arpra_range *t, const arpra_range **x,
-           const arpra_uint x_grp, const arpra_uint x_dim)
+           const arpra_uint x_grp)
 {
     const struct dRdt_params *p = (struct dRdt_params *) params;
-    const arpra_range *R = &(x[x_grp][x_dim]);
     const arpra_range *a = p->a;
     const arpra_range *b = p->b;
     const arpra_range *k = p->k;
-    const arpra_range *VPre = p->in[x_dim % p->pre_syn_size] ? p->VPre_hi : p->VPre_lo;
     const arpra_range *threshold = p->threshold;
     const arpra_range *pos_1 = p->pos_1;
+    arpra_range *Q_lo = p->Q_lo;
+    arpra_range *Q_hi = p->Q_hi;
     arpra_range *temp1 = p->temp1;
-    arpra_range *temp2 = p->temp2;
+    const arpra_range *R;
+    arpra_uint i;
 
     // Sigmoid of threshold difference
-    arpra_sub(temp1, VPre, threshold);
-    arpra_mul(temp1, temp1, k);
-    arpra_exp(temp1, temp1);
-    arpra_add(temp1, temp1, pos_1);
-    arpra_inv(temp1, temp1);
+    arpra_sub(Q_lo, p->VPre_lo, threshold);
+    arpra_mul(Q_lo, Q_lo, k);
+    arpra_exp(Q_lo, Q_lo);
+    arpra_add(Q_lo, Q_lo, pos_1);
+    arpra_inv(Q_lo, Q_lo);
+    arpra_sub(Q_hi, p->VPre_hi, threshold);
+    arpra_mul(Q_hi, Q_hi, k);
+    arpra_exp(Q_hi, Q_hi);
+    arpra_add(Q_hi, Q_hi, pos_1);
+    arpra_inv(Q_hi, Q_hi);
 
     // Presynaptic transmitter release rise
-    arpra_mul(temp1, a, temp1);
+    arpra_mul(Q_lo, a, Q_lo);
+    arpra_mul(Q_hi, a, Q_hi);
 
-    // Presynaptic transmitter release decay
-    arpra_mul(temp2, b, R);
+    for (i = 0; i < p->size; i++) {
+        R = &(x[x_grp][i]);
 
-    // delta of presynaptic transmitter release
-    // dR/dt = a Q - b R
-    // Q = 1 / (1 + e^(k(V - threshold)))
-    arpra_sub(y, temp1, temp2);
+        // Presynaptic transmitter release decay
+        arpra_mul(temp1, b, R);
+
+        // delta of presynaptic transmitter release
+        // dR/dt = a Q - b R
+        // Q = 1 / (1 + e^(k(V - threshold)))
+        arpra_sub(&(y[x_grp][i]), (p->in[i % p->pre_syn_size] ? Q_hi : Q_lo), temp1);
+    }
 }
 
 struct dSdt_params
@@ -537,7 +514,7 @@ void dSdt (arpra_range *y, const void *params,
 
 int main (int argc, char *argv[])
 {
-    arpra_uint i, j;
+    arpra_uint i, j, w;
     arpra_range h, sys_t;
 
     enum grps {
@@ -546,16 +523,20 @@ int main (int argc, char *argv[])
         grp_syn_R, grp_syn_S,
     };
 
-    if (argc != 4) {
-        printf("Usage: hodgkin_huxley <AA method> <input size> <input frequency>\n");
+    if ((argc != 4) && (argc != 5)) {
+        printf("Usage: hodgkin_huxley <AA method> <input size> <input frequency> [threads]\n");
         exit(0);
     }
 
     int method = atoi(argv[1]);
     in_size_arg = atoi(argv[2]);
     in_freq_arg = atoi(argv[3]);
+    if (argc == 5) {
+        threads_arg = atoi(argv[4]);
+    }
     printf("in size: %u\n", in_size_arg);
     printf("in freq: %u\n", in_freq_arg);
+    printf("threads: %lu\n", threads_arg);
 
     if (method == 0) {
         printf("AA method\n");
@@ -571,6 +552,7 @@ int main (int argc, char *argv[])
     }
 
     arpra_set_internal_precision(p_prec_internal);
+    arpra_set_threads(p_threads);
 
     // Initialise arpra_reduce_small_rel threshold.
     mpfr_t reduce_rel;
@@ -587,24 +569,26 @@ int main (int argc, char *argv[])
 
     // Allocate other arrays
     arpra_range *syn_GSyn = malloc(p_syn_size * sizeof(arpra_range));
-    arpra_range *I = malloc(p_in_size * sizeof(arpra_range));
     int *in = malloc(p_in_size * sizeof(int));
-    arpra_uint *nrn_M_reduce_epoch = malloc(p_nrn_size * sizeof(arpra_uint));
-    arpra_uint *nrn_H_reduce_epoch = malloc(p_nrn_size * sizeof(arpra_uint));
-    arpra_uint *nrn_N_reduce_epoch = malloc(p_nrn_size * sizeof(arpra_uint));
-    arpra_uint *nrn_V_reduce_epoch = malloc(p_nrn_size * sizeof(arpra_uint));
-    arpra_uint *syn_R_reduce_epoch = malloc(p_syn_size * sizeof(arpra_uint));
-    arpra_uint *syn_S_reduce_epoch = malloc(p_syn_size * sizeof(arpra_uint));
+
+    // Allocate scratch space for each thread
+    arpra_range *I = malloc(p_threads * p_in_size * sizeof(arpra_range));
+    arpra_range *temp1 = malloc(p_threads * sizeof(arpra_range));
+    arpra_range *temp2 = malloc(p_threads * sizeof(arpra_range));
+    arpra_range *temp3 = malloc(p_threads * sizeof(arpra_range));
+    arpra_range *_a = malloc(p_threads * sizeof(arpra_range));
+    arpra_range *_b = malloc(p_threads * sizeof(arpra_range));
+    arpra_range *syn_Q_lo = malloc(p_threads * sizeof(arpra_range));
+    arpra_range *syn_Q_hi = malloc(p_threads * sizeof(arpra_range));
 
     mpfr_t in_p0, rand_uf, rand_nf;
     arpra_range nrn_GL, nrn_VL, nrn_GNa, nrn_VNa, nrn_GK, nrn_VK,
-        nrn_C, syn_VSyn, syn_thr, syn_a, syn_b, syn_k,
-        temp1, temp2, _a, _b, in_V_lo, in_V_hi;
+        nrn_C, syn_VSyn, syn_thr, syn_a, syn_b, syn_k, in_V_lo, in_V_hi;
     arpra_range pos_1, pos_4, pos_5, pos_25, neg_52, pos_028, pos_032,
-	pos_0128, neg_48, pos_18, neg_25,
+	pos_0128, neg_48, pos_18,
 	pos_05, pos_0032, neg_50, neg_55, pos_40;
 
-    struct timespec clock_time;
+    struct timespec clock_time, run_start, run_end;
 
     // Initialise uniform float RNG
     gmp_randstate_t rng_uf;
@@ -668,14 +652,12 @@ int main (int argc, char *argv[])
     arpra_init2(&syn_b, p_prec);
     arpra_init2(&syn_k, p_prec);
 
-
     // Initialise constants
     arpra_init2(&pos_1, p_prec);
     arpra_init2(&pos_4, p_prec);
     arpra_init2(&pos_5, p_prec);
     arpra_init2(&pos_18, p_prec);
     arpra_init2(&pos_25, p_prec);
-    arpra_init2(&neg_25, p_prec);
     arpra_init2(&neg_48, p_prec);
     arpra_init2(&pos_40, p_prec);
     arpra_init2(&neg_50, p_prec);
@@ -690,11 +672,16 @@ int main (int argc, char *argv[])
     // Initialise scratch space
     mpfr_init2(rand_uf, p_rand_prec);
     mpfr_init2(rand_nf, p_rand_prec);
-    arpra_init2(&temp1, p_prec);
-    arpra_init2(&temp2, p_prec);
-    arpra_init2(&_a, p_prec);
-    arpra_init2(&_b, p_prec);
-    for (i = 0; i < p_in_size; i++) {
+    for (w = 0; w < p_threads; w++) {
+        arpra_init2(&(temp1[w]), p_prec);
+        arpra_init2(&(temp2[w]), p_prec);
+        arpra_init2(&(temp3[w]), p_prec);
+        arpra_init2(&(_a[w]), p_prec);
+        arpra_init2(&(_b[w]), p_prec);
+        arpra_init2(&(syn_Q_lo[w]), p_prec);
+        arpra_init2(&(syn_Q_hi[w]), p_prec);
+    }
+    for (i = 0; i < p_threads * p_in_size; i++) {
         arpra_init2(&(I[i]), p_prec);
     }
 
@@ -747,7 +734,6 @@ int main (int argc, char *argv[])
     arpra_set_d(&pos_5, 5.0);
     arpra_set_d(&pos_18, 18.0);
     arpra_set_d(&pos_25, 25.0);
-    arpra_set_d(&neg_25, -25.0);
     arpra_set_d(&pos_40, 40.0);
     arpra_set_d(&neg_48, -48.0);
     arpra_set_d(&neg_50, -50.0);
@@ -805,92 +791,82 @@ int main (int argc, char *argv[])
     /* FILE **f_syn_S_d = malloc(p_syn_size * sizeof(FILE *)); */
     /* file_init("syn_S", p_syn_size, f_syn_S_c, f_syn_S_r, f_syn_S_n, f_syn_S_s, f_syn_S_d); */
 
-    // Set parameter structs
-    struct dMdt_params params_nrn_M = {
-        .grp_V = grp_nrn_V,
-        .pos_1 = &pos_1,
-        .pos_4 = &pos_4,
-        .pos_5 = &pos_5,
-        .pos_25 = &pos_25,
-        .neg_52 = &neg_52,
-        .pos_028 = &pos_028,
-        .pos_032 = &pos_032,
-        .temp1 = &temp1,
-        .temp2 = &temp2,
-        ._a = &_a,
-        ._b = &_b,
-    };
-
-    struct dHdt_params params_nrn_H = {
-        .grp_V = grp_nrn_V,
-        .pos_1 = &pos_1,
-        .pos_4 = &pos_4,
-        .pos_5 = &pos_5,
-        .pos_18 = &pos_18,
-        .neg_25 = &neg_25,
-        .neg_48 = &neg_48,
-        .pos_0128 = &pos_0128,
-        .temp1 = &temp1,
-        .temp2 = &temp2,
-        ._a = &_a,
-        ._b = &_b,
-    };
-
-    struct dNdt_params params_nrn_N = {
-        .grp_V = grp_nrn_V,
-	.pos_1 = &pos_1,
-	.pos_5 = &pos_5,
-	.pos_40 = &pos_40,
-	.neg_50 = &neg_50,
-	.neg_55 = &neg_55,
-	.pos_0032 = &pos_0032,
-	.pos_05 = &pos_05,
-        .temp1 = &temp1,
-        .temp2 = &temp2,
-        ._a = &_a,
-        ._b = &_b,
-    };
-
-    struct dVdt_params params_nrn_V = {
-        .grp_M = grp_nrn_M,
-        .grp_H = grp_nrn_H,
-        .grp_N = grp_nrn_N,
-        .grp_S = grp_syn_S,
-        .GSyn = syn_GSyn,
-        .VSyn = &syn_VSyn,
-        .GL = &nrn_GL,
-        .VL = &nrn_VL,
-        .GNa = &nrn_GNa,
-        .VNa = &nrn_VNa,
-        .GK = &nrn_GK,
-        .VK = &nrn_VK,
-        .C = &nrn_C,
-        .pre_syn_size = p_in_size,
-        .I = I,
-        .temp1 = &temp1,
-    };
-
-    struct dRdt_params params_syn_R = {
-        .a = &syn_a,
-        .b = &syn_b,
-        .k = &syn_k,
-        .VPre_lo = &in_V_lo,
-        .VPre_hi = &in_V_hi,
-        .threshold = &syn_thr,
-        .in = in,
-        .pre_syn_size = p_in_size,
-        .pos_1 = &pos_1,
-        .temp1 = &temp1,
-        .temp2 = &temp2,
-    };
-
-    struct dSdt_params params_syn_S = {
-        .grp_R = grp_syn_R,
-        .a = &syn_a,
-        .b = &syn_b,
-        .temp1 = &temp1,
-        .temp2 = &temp2,
-    };
+    // Set parameter structs, with scratch space for each thread
+    struct dMHNdt_params *params_nrn_MHN = malloc(p_threads * sizeof(struct dMHNdt_params));
+    struct dVdt_params *params_nrn_V = malloc(p_threads * sizeof(struct dVdt_params));
+    struct dRdt_params *params_syn_R = malloc(p_threads * sizeof(struct dRdt_params));
+    struct dSdt_params *params_syn_S = malloc(p_threads * sizeof(struct dSdt_params));
+    for (w = 0; w < p_threads; w++) {
+        params_nrn_MHN[w] = (struct dMHNdt_params) {
+            .grp_H = grp_nrn_H,
+            .grp_N = grp_nrn_N,
+            .grp_V = grp_nrn_V,
+            .size = p_nrn_size,
+            .pos_1 = &pos_1,
+            .pos_4 = &pos_4,
+            .pos_5 = &pos_5,
+            .pos_18 = &pos_18,
+            .pos_25 = &pos_25,
+            .pos_40 = &pos_40,
+            .neg_48 = &neg_48,
+            .neg_50 = &neg_50,
+            .neg_52 = &neg_52,
+            .neg_55 = &neg_55,
+            .pos_028 = &pos_028,
+            .pos_032 = &pos_032,
+            .pos_0128 = &pos_0128,
+            .pos_0032 = &pos_0032,
+            .pos_05 = &pos_05,
+            .temp1 = &(temp1[w]),
+            .temp2 = &(temp2[w]),
+            .temp3 = &(temp3[w]),
+            ._a = &(_a[w]),
+            ._b = &(_b[w]),
+        };
+
+        params_nrn_V[w] = (struct dVdt_params) {
+            .grp_M = grp_nrn_M,
+            .grp_H = grp_nrn_H,
+            .grp_N = grp_nrn_N,
+            .grp_S = grp_syn_S,
+            .GSyn = syn_GSyn,
+            .VSyn = &syn_VSyn,
+            .GL = &nrn_GL,
+            .VL = &nrn_VL,
+            .GNa = &nrn_GNa,
+            .VNa = &nrn_VNa,
+            .GK = &nrn_GK,
+            .VK = &nrn_VK,
+            .C = &nrn_C,
+            .pre_syn_size = p_in_size,
+            .I = &(I[w * p_in_size]),
+            .temp1 = &(temp1[w]),
+        };
+
+        params_syn_R[w] = (struct dRdt_params) {
+            .a = &syn_a,
+            .b = &syn_b,
+            .k = &syn_k,
+            .VPre_lo = &in_V_lo,
+            .VPre_hi = &in_V_hi,
+            .threshold = &syn_thr,
+            .in = in,
+            .pre_syn_size = p_in_size,
+            .size = p_syn_size,
+            .pos_1 = &pos_1,
+            .Q_lo = &(syn_Q_lo[w]),
+            .Q_hi = &(syn_Q_hi[w]),
+            .temp1 = &(temp1[w]),
+        };
+
+        params_syn_S[w] = (struct dSdt_params) {
+            .grp_R = grp_syn_R,
+            .a = &syn_a,
+            .b = &syn_b,
+            .temp1 = &(temp1[w]),
+            .temp2 = &(temp2[w]),
+        };
+    }
 
     // ODE system
     arpra_uint sys_grps = 6;
@@ -900,23 +876,33 @@ int main (int argc, char *argv[])
         p_syn_size, p_syn_size,
     };
     arpra_ode_f sys_f[6] = {
-        dMdt, dHdt, dNdt, dVdt, dRdt, dSdt,
+        NULL, NULL, NULL, dVdt, NULL, dSdt,
     };
-    void *sys_params[6] = {
-        &params_nrn_M, &params_nrn_H,
-        &params_nrn_N, &params_nrn_V,
-        &params_syn_R, &params_syn_S,
+    arpra_ode_f_grp sys_f_grp[6] = {
+        dMHNdt, NULL, NULL, NULL, dRdt, NULL,
     };
+    void ***sys_params = malloc(p_threads * sizeof(void **));
+    for (w = 0; w < p_threads; w++) {
+        sys_params[w] = malloc(6 * sizeof(void *));
+        sys_params[w][grp_nrn_M] = &(params_nrn_MHN[w]);
+        sys_params[w][grp_nrn_H] = NULL;
+        sys_params[w][grp_nrn_N] = NULL;
+        sys_params[w][grp_nrn_V] = &(params_nrn_V[w]);
+        sys_params[w][grp_syn_R] = &(params_syn_R[w]);
+        sys_params[w][grp_syn_S] = &(params_syn_S[w]);
+    }
     arpra_range *sys_x[6] = {
         nrn_M, nrn_H, nrn_N, nrn_V, syn_R, syn_S,
     };
     arpra_ode_system ode_system = {
         .f = sys_f,
-        .params = sys_params,
+        .f_grp = sys_f_grp,
         .t = &sys_t,
         .x = sys_x,
         .grps = sys_grps,
         .dims = sys_dims,
+        .worker_params = sys_params,
+        .workers = p_threads,
     };
 
     // ODE stepper
@@ -927,26 +913,23 @@ int main (int argc, char *argv[])
     //arpra_ode_stepper_init(&ode_stepper, &ode_system, arpra_ode_dopri54);
     //arpra_ode_stepper_init(&ode_stepper, &ode_system, arpra_ode_dopri87);
 
+    // Deviation term reduction policy
+    arpra_ode_reduce ode_reduce = {
+        .new_terms = 1,
+        .rel_threshold = reduce_rel,
+        .rel_steps = p_reduce_step,
+    };
+    arpra_ode_stepper_set_reduce(&ode_stepper, &ode_reduce);
+
 
     // Begin simulation loop
     // =====================
 
-    clock_t run_time = clock();
+    clock_gettime(CLOCK_MONOTONIC, &run_start);
 
     for (i = 0; i < p_sim_steps; i++) {
         if (i % p_report_step == 0) printf("%lu\n", i);
 
-        for (j = 0; j < p_nrn_size; j++) {
-            nrn_M_reduce_epoch[j] = ode_system.x[grp_nrn_M][j].nTerms;
-            nrn_H_reduce_epoch[j] = ode_system.x[grp_nrn_H][j].nTerms;
-            nrn_N_reduce_epoch[j] = ode_system.x[grp_nrn_N][j].nTerms;
-            nrn_V_reduce_epoch[j] = ode_system.x[grp_nrn_V][j].nTerms;
-        }
-        for (j = 0; j < p_syn_size; j++) {
-            syn_R_reduce_epoch[j] = ode_system.x[grp_syn_R][j].nTerms;
-            syn_S_reduce_epoch[j] = ode_system.x[grp_syn_S][j].nTerms;
-        }
-
         // Event(s) occur if urandom >= e^-rate
         for (j = 0; j < p_in_size; j++) {
             mpfr_urandom(rand_uf, rng_uf, MPFR_RNDN);
@@ -958,37 +941,6 @@ int main (int argc, char *argv[])
         // Step system
         arpra_ode_stepper_step(&ode_stepper, &h);
 
-        arpra_uint reduce_n;
-        for (j = 0; j < p_nrn_size; j++) {
-            reduce_n = ode_system.x[grp_nrn_M][j].nTerms - nrn_M_reduce_epoch[j];
-            arpra_reduce_last_n(&(ode_system.x[grp_nrn_M][j]), &(ode_system.x[grp_nrn_M][j]), reduce_n);
-            reduce_n = ode_system.x[grp_nrn_H][j].nTerms - nrn_H_reduce_epoch[j];
-            arpra_reduce_last_n(&(ode_system.x[grp_nrn_H][j]), &(ode_system.x[grp_nrn_H][j]), reduce_n);
-            reduce_n = ode_system.x[grp_nrn_N][j].nTerms - nrn_N_reduce_epoch[j];
-            arpra_reduce_last_n(&(ode_system.x[grp_nrn_N][j]), &(ode_system.x[grp_nrn_N][j]), reduce_n);
-            reduce_n = ode_system.x[grp_nrn_V][j].nTerms - nrn_V_reduce_epoch[j];
-            arpra_reduce_last_n(&(ode_system.x[grp_nrn_V][j]), &(ode_system.x[grp_nrn_V][j]), reduce_n);
-        }
-        for (j = 0; j < p_syn_size; j++) {
-            reduce_n = ode_system.x[grp_syn_R][j].nTerms - syn_R_reduce_epoch[j];
-            arpra_reduce_last_n(&(ode_system.x[grp_syn_R][j]), &(ode_system.x[grp_syn_R][j]), reduce_n);
-            reduce_n = ode_system.x[grp_syn_S][j].nTerms - syn_S_reduce_epoch[j];
-            arpra_reduce_last_n(&(ode_system.x[grp_syn_S][j]), &(ode_system.x[grp_syn_S][j]), reduce_n);
-        }
-
-        if (i % p_reduce_step == 0) {
-            for (j = 0; j < p_nrn_size; j++) {
-                arpra_reduce_small_rel(&(ode_system.x[grp_nrn_M][j]), &(ode_system.x[grp_nrn_M][j]), reduce_rel);
-                arpra_reduce_small_rel(&(ode_system.x[grp_nrn_H][j]), &(ode_system.x[grp_nrn_H][j]), reduce_rel);
-                arpra_reduce_small_rel(&(ode_system.x[grp_nrn_N][j]), &(ode_system.x[grp_nrn_N][j]), reduce_rel);
-                arpra_reduce_small_rel(&(ode_system.x[grp_nrn_V][j]), &(ode_system.x[grp_nrn_V][j]), reduce_rel);
-            }
-            for (j = 0; j < p_syn_size; j++) {
-                arpra_reduce_small_rel(&(ode_system.x[grp_syn_R][j]), &(ode_system.x[grp_syn_R][j]), reduce_rel);
-                arpra_reduce_small_rel(&(ode_system.x[grp_syn_S][j]), &(ode_system.x[grp_syn_S][j]), reduce_rel);
-            }
-        }
-
         file_write(&sys_t, 1, f_time_c, f_time_r, f_time_n, f_time_s, f_time_d);
 
         file_write(nrn_M, p_nrn_size, f_nrn_M_c, f_nrn_M_r, f_nrn_M_n, f_nrn_M_s, f_nrn_M_d);
@@ -1000,8 +952,9 @@ int main (int argc, char *argv[])
         /* file_write(syn_S, p_syn_size, f_syn_S_c, f_syn_S_r, f_syn_S_n, f_syn_S_s, f_syn_S_d); */
     }
 
-    run_time = clock() - run_time;
-    printf("Finished in %f seconds.\n", ((float) run_time) / CLOCKS_PER_SEC);
+    clock_gettime(CLOCK_MONOTONIC, &run_end);
+    printf("Finished in %f seconds.\n", (run_end.tv_sec - run_start.tv_sec)
+           + ((run_end.tv_nsec - run_start.tv_nsec) / 1.0E9));
 
     // End simulation loop
     // ===================
@@ -1054,7 +1007,6 @@ int main (int argc, char *argv[])
     arpra_clear(&pos_5);
     arpra_clear(&pos_18);
     arpra_clear(&pos_25);
-    arpra_clear(&neg_25);
     arpra_clear(&pos_40);
     arpra_clear(&neg_48);
     arpra_clear(&neg_50);
@@ -1069,11 +1021,16 @@ int main (int argc, char *argv[])
     // Clear scratch space
     mpfr_clear(rand_uf);
     mpfr_clear(rand_nf);
-    arpra_clear(&temp1);
-    arpra_clear(&temp2);
-    arpra_clear(&_a);
-    arpra_clear(&_b);
-    for (i = 0; i < p_in_size; i++) {
+    for (w = 0; w < p_threads; w++) {
+        arpra_clear(&(temp1[w]));
+        arpra_clear(&(temp2[w]));
+        arpra_clear(&(temp3[w]));
+        arpra_clear(&(_a[w]));
+        arpra_clear(&(_b[w]));
+        arpra_clear(&(syn_Q_lo[w]));
+        arpra_clear(&(syn_Q_hi[w]));
+    }
+    for (i = 0; i < p_threads * p_in_size; i++) {
         arpra_clear(&(I[i]));
     }
 
@@ -1087,14 +1044,25 @@ int main (int argc, char *argv[])
 
     // Free other arrays
     free(syn_GSyn);
-    free(I);
     free(in);
-    free(nrn_M_reduce_epoch);
-    free(nrn_H_reduce_epoch);
-    free(nrn_N_reduce_epoch);
-    free(nrn_V_reduce_epoch);
-    free(syn_R_reduce_epoch);
-    free(syn_S_reduce_epoch);
+
+    // Free scratch space and parameter structs
+    free(I);
+    free(temp1);
+    free(temp2);
+    free(temp3);
+    free(_a);
+    free(_b);
+    free(syn_Q_lo);
+    free(syn_Q_hi);
+    for (w = 0; w < p_threads; w++) {
+        free(sys_params[w]);
+    }
+    free(sys_params);
+    free(params_nrn_MHN);
+    free(params_nrn_V);
+    free(params_syn_R);
+    free(params_syn_S);
 
     // Clear report files
     file_clear(1, f_time_c, f_time_r, f_time_n, f_time_s, f_time_d);
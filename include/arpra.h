@@ -22,34 +22,50 @@
 #ifndef ARPRA_H
 #define ARPRA_H
 
+#include <stdint.h>
 #include <mpfr.h>
 #include <mpfi.h>
+#include <arpra_config.h>
 
 // Arpra type definitions.
 typedef long int arpra_int;
 typedef unsigned long int arpra_uint;
 typedef mpfr_prec_t arpra_prec;
+#if ARPRA_SYMBOL_32
+typedef uint32_t arpra_symbol;
+#else
+typedef unsigned long int arpra_symbol;
+#endif
+
+// Range analysis method enum. ARPRA_IA keeps only the MPFI range, and
+// ARPRA_GLOBAL_RANGE_METHOD makes a range follow arpra_get_range_method().
+typedef enum arpra_range_method_enum arpra_range_method;
+enum arpra_range_method_enum
+{
+    ARPRA_AA,
+    ARPRA_MIXED_IAAA,
+    ARPRA_MIXED_TRIMMED_IAAA,
+    ARPRA_IA,
+    ARPRA_GLOBAL_RANGE_METHOD,
+};
 
 // The Arpra range struct.
 typedef struct arpra_range_struct arpra_range;
 struct arpra_range_struct
 {
     arpra_prec precision;
+    arpra_prec deviation_precision;
+    arpra_prec internal_precision;
+    arpra_range_method range_method;
     __mpfr_struct centre;
     __mpfr_struct radius;
     __mpfi_struct true_range;
-    arpra_uint *symbols;
+    arpra_symbol *symbols;
     __mpfr_struct *deviations;
     arpra_uint nTerms;
-};
-
-// Range analysis method enum.
-typedef enum arpra_range_method_enum arpra_range_method;
-enum arpra_range_method_enum
-{
-    ARPRA_AA,
-    ARPRA_MIXED_IAAA,
-    ARPRA_MIXED_TRIMMED_IAAA,
+    arpra_uint wide_ops;
+    int dirty;
+    arpra_uint *refs;
 };
 
 // Multiplication method enum.
@@ -60,6 +76,24 @@ enum arpra_mul_method_enum
     ARPRA_MUL_RUMP_KASHIWAGI,
 };
 
+// Noise symbol class enum.
+typedef enum arpra_symbol_class_enum arpra_symbol_class;
+enum arpra_symbol_class_enum
+{
+    ARPRA_SYMBOL_ROUNDING,
+    ARPRA_SYMBOL_APPROXIMATION,
+    ARPRA_SYMBOL_INPUT,
+    ARPRA_SYMBOL_PARAMETER,
+};
+
+// Vector reduction method enum.
+typedef enum arpra_reduce_method_enum arpra_reduce_method;
+enum arpra_reduce_method_enum
+{
+    ARPRA_REDUCE_BOX,
+    ARPRA_REDUCE_PCA,
+};
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -67,7 +101,10 @@ extern "C" {
 // Initialise and clear.
 void arpra_init (arpra_range *y);
 void arpra_init2 (arpra_range *y, arpra_prec prec);
+void arpra_init3 (arpra_range *y, arpra_prec prec, arpra_prec prec_internal);
 void arpra_clear (arpra_range *y);
+void arpra_swap (arpra_range *x1, arpra_range *x2);
+void arpra_move (arpra_range *y, arpra_range *x1);
 
 // Get from an Arpra range.
 void arpra_get_bounds (mpfr_ptr y_lo, mpfr_ptr y_hi, const arpra_range *x);
@@ -104,11 +141,20 @@ void arpra_inv (arpra_range *y, const arpra_range *x1);
 // Summation operations.
 void arpra_sum (arpra_range *y, arpra_range *x, arpra_uint n);
 void arpra_sum_recursive (arpra_range *y, arpra_range *x, arpra_uint n);
+void arpra_sum_parallel (arpra_range *y, arpra_range *x, arpra_uint n);
 
 // Deviation term reduction.
 void arpra_reduce_last_n (arpra_range *y, const arpra_range *x1, arpra_uint n);
 void arpra_reduce_small_abs (arpra_range *y, const arpra_range *x1, mpfr_srcptr abs_threshold);
 void arpra_reduce_small_rel (arpra_range *y, const arpra_range *x1, mpfr_srcptr rel_threshold);
+void arpra_reduce_keep_k (arpra_range *y, const arpra_range *x1, arpra_uint k);
+void arpra_reduce_vector (arpra_range *y, const arpra_range *x, arpra_uint n, arpra_uint k);
+
+// Noise symbols. arpra_renumber_symbols replaces the m distinct symbols of
+// the n ranges in x by (rank << 2) | class, ranking them 0 to m - 1 in their
+// original order, and restarts new symbols after them.
+arpra_symbol_class arpra_get_term_class (const arpra_range *x1, arpra_uint i);
+void arpra_renumber_symbols (arpra_range **x, arpra_uint n);
 
 // Predicates on Arpra ranges.
 int arpra_nan_p (const arpra_range *x1);
@@ -147,16 +193,51 @@ void arpra_mpfr_set_str (arpra_range *y, const char *x1, int base);
 // Floating-point precision.
 arpra_prec arpra_get_precision (const arpra_range *x1);
 void arpra_set_precision (arpra_range *y, arpra_prec prec);
+arpra_prec arpra_get_deviation_precision (const arpra_range *x1);
+void arpra_set_deviation_precision (arpra_range *y, arpra_prec prec);
+
+// Per-range analysis method.
+arpra_range_method arpra_get_local_range_method (const arpra_range *x1);
+void arpra_set_local_range_method (arpra_range *y, arpra_range_method new_range_method);
 
 // Arpra configuration.
 arpra_range_method arpra_get_range_method ();
 void arpra_set_range_method (arpra_range_method new_range_method);
 arpra_mul_method arpra_get_mul_method ();
 void arpra_set_mul_method (arpra_mul_method new_mul_method);
+arpra_reduce_method arpra_get_reduce_method ();
+void arpra_set_reduce_method (arpra_reduce_method new_reduce_method);
+arpra_symbol_class arpra_get_symbol_class ();
+void arpra_set_symbol_class (arpra_symbol_class new_symbol_class);
+unsigned int arpra_get_reduce_classes ();
+void arpra_set_reduce_classes (unsigned int new_reduce_classes);
 arpra_prec arpra_get_default_precision ();
 void arpra_set_default_precision (arpra_prec prec);
 arpra_prec arpra_get_internal_precision ();
 void arpra_set_internal_precision (arpra_prec prec);
+int arpra_get_adaptive_precision ();
+void arpra_set_adaptive_precision (int enable);
+arpra_uint arpra_get_adaptive_precision_count (arpra_prec prec);
+void arpra_reset_adaptive_precision_stats ();
+int arpra_get_adaptive_collapse ();
+void arpra_set_adaptive_collapse (int enable);
+arpra_uint arpra_get_adaptive_collapse_count ();
+void arpra_reset_adaptive_collapse_stats ();
+// With adaptive collapse, a range is collapsed to an interval after ops
+// operations in a row whose affine width is more than ratio times their
+// mixed width, or once it has more than terms deviation terms.
+arpra_uint arpra_get_collapse_ratio ();
+void arpra_set_collapse_ratio (arpra_uint ratio);
+arpra_uint arpra_get_collapse_ops ();
+void arpra_set_collapse_ops (arpra_uint ops);
+arpra_uint arpra_get_collapse_terms ();
+void arpra_set_collapse_terms (arpra_uint terms);
+int arpra_get_lazy_range ();
+void arpra_set_lazy_range (int enable);
+arpra_prec arpra_get_default_deviation_precision ();
+void arpra_set_default_deviation_precision (arpra_prec prec);
+arpra_uint arpra_get_threads ();
+void arpra_set_threads (arpra_uint n);
 
 // Clear temporary data.
 void arpra_clear_buffers ();
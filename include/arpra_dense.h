@@ -0,0 +1,76 @@
+/*
+ * arpra_dense.h -- Arpra public header for dense affine vectors.
+ *
+ * Copyright 2016-2020 James Paul Turner.
+ *
+ * This file is part of the Arpra library.
+ *
+ * The Arpra library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Arpra library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with the Arpra library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ARPRA_DENSE_H
+#define ARPRA_DENSE_H
+
+#include <arpra.h>
+#include <arpra_ode.h>
+
+// Arpra dense typedefs.
+typedef struct arpra_dense_struct arpra_dense;
+
+// Dense affine vector.
+//
+// A vector of rows ranges sharing a basis of cols noise symbols, sorted in
+// increasing order. Row i is centre[i] + sum_j deviations[i * cols + j]
+// basis[j], plus an independent error term of magnitude error[i] that is
+// not in the basis. The basis is fixed when a vector is set from ranges,
+// and operands with different bases are aligned on the union of them.
+struct arpra_dense_struct
+{
+    arpra_prec precision;
+    arpra_uint rows;
+    arpra_uint cols;
+    arpra_symbol *basis;
+    __mpfr_struct *centre;
+    __mpfr_struct *deviations;
+    __mpfr_struct *error;
+};
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Initialise and clear.
+void arpra_dense_init (arpra_dense *y, arpra_uint rows);
+void arpra_dense_init2 (arpra_dense *y, arpra_uint rows, arpra_prec prec);
+void arpra_dense_clear (arpra_dense *y);
+
+// Conversion to and from Arpra ranges.
+void arpra_dense_set_range (arpra_dense *y, const arpra_range *x);
+void arpra_dense_get_range (arpra_range *y, const arpra_dense *x);
+void arpra_dense_set_ode_state (arpra_dense *y, const arpra_ode_system *system);
+void arpra_dense_get_ode_state (arpra_ode_system *system, const arpra_dense *x);
+
+// Affine operations. Operands have y->rows rows, except x1 of affine,
+// which has any number of rows n, and a which is a y->rows by n row-major
+// matrix. The matrix a and vector b of affine are exact, and b can be NULL.
+void arpra_dense_add (arpra_dense *y, const arpra_dense *x1, const arpra_dense *x2);
+void arpra_dense_sub (arpra_dense *y, const arpra_dense *x1, const arpra_dense *x2);
+void arpra_dense_axpy (arpra_dense *y, mpfr_srcptr a, const arpra_dense *x1, const arpra_dense *x2);
+void arpra_dense_affine (arpra_dense *y, mpfr_srcptr a, const arpra_dense *x1, mpfr_srcptr b);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ARPRA_DENSE_H
@@ -28,19 +28,45 @@
 typedef struct arpra_ode_system_struct arpra_ode_system;
 typedef struct arpra_ode_stepper_struct arpra_ode_stepper;
 typedef struct arpra_ode_method_struct arpra_ode_method;
+typedef struct arpra_ode_reduce_struct arpra_ode_reduce;
 typedef void (*arpra_ode_f) (arpra_range *dxdt, const void *params,
                              const arpra_range *t, const arpra_range **x,
                              const arpra_uint x_grp, const arpra_uint x_dim);
+typedef void (*arpra_ode_f_grp) (arpra_range **dxdt, const void *params,
+                                 const arpra_range *t, const arpra_range **x,
+                                 const arpra_uint x_grp);
 
 // System definition.
+//
+// The derivatives of group x_grp are computed by f_grp[x_grp] if it is
+// not NULL, else by f[x_grp] once per dimension. A group callback fills
+// dxdt[x_grp][0 ... dims[x_grp] - 1], and may also fill other groups that
+// are computed jointly with it, as long as those groups have NULL entries
+// in both f and f_grp. Either array can be NULL if it is unused.
+//
+// Callbacks are given params[x_grp]. If worker_params is not NULL, they are
+// instead given worker_params[w][x_grp], where w is the index of the thread
+// running them, from 0 to workers - 1, so that each thread can have its own
+// scratch ranges. The calling thread is thread 0, and at most workers
+// threads are used to evaluate the system.
+//
+// If arpra_set_threads is given more than one thread, callbacks are run
+// concurrently, and must only write to their own dxdt elements and their
+// own thread's params. Ranges
+// that callbacks share through params must not be left dirty by lazy range
+// computation; reading their range, for instance with arpra_get_mpfi, will
+// clean them.
 struct arpra_ode_system_struct
 {
     arpra_ode_f *f;
+    arpra_ode_f_grp *f_grp;
     void **params;
     arpra_range *t;
     arpra_range **x;
     arpra_uint grps;
     arpra_uint *dims;
+    void ***worker_params;
+    arpra_uint workers;
 };
 
 // Stepper definition.
@@ -50,17 +76,47 @@ struct arpra_ode_stepper_struct
     arpra_ode_system *system;
     arpra_range *error;
     void *scratch;
+    const arpra_ode_reduce *reduce;
+    arpra_uint reduce_epoch;
+    arpra_uint steps;
 };
 
 // Step method definition.
+//
+// If consts is not NULL, it returns the number of ranges that the method
+// keeps from one step to the next, and points list to them if list is not
+// NULL.
 struct arpra_ode_method_struct
 {
     void (* const init) (arpra_ode_stepper *stepper, arpra_ode_system *system);
     void (* const clear) (arpra_ode_stepper *stepper);
     void (* const step) (arpra_ode_stepper *stepper, const arpra_range *h);
+    arpra_uint (* const consts) (arpra_ode_stepper *stepper, arpra_range **list);
     const unsigned char stages;
 };
 
+// Deviation term reduction policy.
+//
+// After each step, every state variable has the terms created during that
+// step condensed into one if new_terms is set, and its smallest terms
+// condensed so that at most max_terms remain if max_terms is non-zero.
+// If rel_threshold is not NULL, arpra_reduce_small_rel is also applied on
+// every rel_steps-th step. If per_stage is set, new_terms and max_terms are
+// also applied to every stage of the step.
+//
+// Only terms of the classes in the classes bit mask are condensed, or of
+// those set with arpra_set_reduce_classes if classes is zero. Terms of
+// other classes are always kept, in addition to max_terms.
+struct arpra_ode_reduce_struct
+{
+    int new_terms;
+    arpra_uint max_terms;
+    mpfr_srcptr rel_threshold;
+    arpra_uint rel_steps;
+    int per_stage;
+    unsigned int classes;
+};
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -70,6 +126,8 @@ void arpra_ode_stepper_init (arpra_ode_stepper *stepper, arpra_ode_system *syste
                              const arpra_ode_method *method);
 void arpra_ode_stepper_clear (arpra_ode_stepper *stepper);
 void arpra_ode_stepper_step (arpra_ode_stepper *stepper, const arpra_range *h);
+void arpra_ode_stepper_set_reduce (arpra_ode_stepper *stepper, const arpra_ode_reduce *reduce);
+void arpra_ode_stepper_renumber (arpra_ode_stepper *stepper, arpra_range **x, arpra_uint n);
 
 // Arpra built-in step methods.
 extern const arpra_ode_method *arpra_ode_euler;
@@ -0,0 +1,128 @@
+/*
+ * adaptive_collapse.c -- Collapse affine ranges that stop paying off.
+ *
+ * Copyright 2016-2020 James Paul Turner.
+ *
+ * This file is part of the Arpra library.
+ *
+ * The Arpra library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Arpra library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with the Arpra library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "arpra-impl.h"
+
+/*
+ * With adaptive collapse enabled, the mixed IA/AA methods replace a range
+ * by a single fresh deviation term spanning its mixed range, when its
+ * affine form has been much wider than that range for several operations
+ * in a row, or when it carries too many terms. The count of consecutive
+ * wide operations is inherited from the operands of each operation.
+ *
+ * An operation is wide if the affine width of its result is more than the
+ * collapse ratio times its mixed width. A range is collapsed after the
+ * collapse ops number of wide operations in a row, or once it has more than
+ * the collapse terms number of terms.
+ */
+
+static int adaptive_collapse = 0;
+static arpra_uint adaptive_collapse_count = 0;
+static arpra_uint collapse_ratio = ARPRA_DEFAULT_COLLAPSE_RATIO;
+static arpra_uint collapse_ops = ARPRA_DEFAULT_COLLAPSE_OPS;
+static arpra_uint collapse_terms = ARPRA_DEFAULT_COLLAPSE_TERMS;
+
+int arpra_get_adaptive_collapse ()
+{
+    return adaptive_collapse;
+}
+
+void arpra_set_adaptive_collapse (int enable)
+{
+    adaptive_collapse = enable;
+}
+
+arpra_uint arpra_get_adaptive_collapse_count ()
+{
+    return __atomic_load_n(&adaptive_collapse_count, __ATOMIC_RELAXED);
+}
+
+void arpra_reset_adaptive_collapse_stats ()
+{
+    __atomic_store_n(&adaptive_collapse_count, 0, __ATOMIC_RELAXED);
+}
+
+arpra_uint arpra_get_collapse_ratio ()
+{
+    return collapse_ratio;
+}
+
+void arpra_set_collapse_ratio (arpra_uint ratio)
+{
+    collapse_ratio = ratio;
+}
+
+arpra_uint arpra_get_collapse_ops ()
+{
+    return collapse_ops;
+}
+
+void arpra_set_collapse_ops (arpra_uint ops)
+{
+    collapse_ops = ops;
+}
+
+arpra_uint arpra_get_collapse_terms ()
+{
+    return collapse_terms;
+}
+
+void arpra_set_collapse_terms (arpra_uint terms)
+{
+    collapse_terms = terms;
+}
+
+int arpra_helper_adaptive_collapse (arpra_range *y)
+{
+    mpfr_t temp1, temp2;
+
+    if (!adaptive_collapse) {
+        return 0;
+    }
+
+    // Initialise vars.
+    mpfr_init2(temp1, 32);
+    mpfr_init2(temp2, 32);
+
+    // Is the AA width more than collapse_ratio times the mixed width?
+    mpfr_sub(temp1, &(y->true_range.right), &(y->true_range.left), MPFR_RNDU);
+    mpfr_mul_ui(temp1, temp1, collapse_ratio, MPFR_RNDU);
+    mpfr_mul_2ui(temp2, &(y->radius), 1, MPFR_RNDD);
+    if (mpfr_greater_p(temp2, temp1)) {
+        y->wide_ops++;
+    }
+    else {
+        y->wide_ops = 0;
+    }
+
+    // Clear vars.
+    mpfr_clear(temp1);
+    mpfr_clear(temp2);
+
+    if ((y->wide_ops < collapse_ops) && (y->nTerms <= collapse_terms)) {
+        return 0;
+    }
+
+    // y = mixed range of y, with a fresh symbol.
+    arpra_helper_set_mpfi(y, &(y->true_range), ARPRA_SYMBOL_APPROXIMATION);
+    __atomic_add_fetch(&adaptive_collapse_count, 1, __ATOMIC_RELAXED);
+    return 1;
+}
@@ -59,6 +59,12 @@ void arpra_add (arpra_range *y, const arpra_range *x1, const arpra_range *x2)
         return;
     }
 
+    // Interval method.
+    if (arpra_helper_range_method(y) == ARPRA_IA) {
+        arpra_helper_ia_2(y, mpfi_add, x1, x2);
+        return;
+    }
+
     // Initialise vars.
     mpfi_init2(ia_range, y->precision);
     mpfi_init2(alpha, 2);
@@ -76,14 +82,8 @@ void arpra_add (arpra_range *y, const arpra_range *x1, const arpra_range *x2)
     // y = x1 + x2
     arpra_helper_affine_2(y, x1, x2, alpha, beta, gamma, delta);
 
-    // Compute true_range.
-    arpra_helper_compute_range(y);
-
-    // Mix with IA range, and trim error term.
-    arpra_helper_mix_trim(y, ia_range);
-
-    // Check for NaN and Inf.
-    arpra_helper_check_result(y);
+    // Compute true_range, or defer it until it is needed.
+    arpra_helper_defer_range(y, ia_range);
 
     // Clear vars.
     mpfi_clear(ia_range);
@@ -30,9 +30,11 @@
 #include <stdio.h>
 #include <assert.h>
 #include <math.h>
+#include <limits.h>
 
 #include <arpra.h>
 #include <arpra_ode.h>
+#include <arpra_dense.h>
 
 // Default range analysis method.
 #define ARPRA_DEFAULT_RANGE_METHOD ARPRA_MIXED_TRIMMED_IAAA
@@ -40,16 +42,100 @@
 // Default multiplication method.
 #define ARPRA_DEFAULT_MUL_METHOD ARPRA_MUL_RUMP_KASHIWAGI
 
+// Default vector reduction method.
+#define ARPRA_DEFAULT_REDUCE_METHOD ARPRA_REDUCE_BOX
+
 // Default precisions.
 #define ARPRA_DEFAULT_PRECISION 53
 #define ARPRA_DEFAULT_INTERNAL_PRECISION 256
 
+// Default deviation precision, or 0 for the internal precision.
+#define ARPRA_DEFAULT_DEVIATION_PRECISION 0
+
+// Adaptive precision guard bits, and number of per-limb-count counters.
+#define ARPRA_ADAPTIVE_GUARD 32
+#define ARPRA_ADAPTIVE_COUNTERS 16
+
+// Default adaptive collapse thresholds.
+#define ARPRA_DEFAULT_COLLAPSE_RATIO 4
+#define ARPRA_DEFAULT_COLLAPSE_OPS 8
+#define ARPRA_DEFAULT_COLLAPSE_TERMS 256
+
+// Dirty flag states. Dirty ranges have deviation terms and a radius, but
+// their true_range is only an MPFI enclosure.
+#define ARPRA_RANGE_CLEAN 0
+#define ARPRA_RANGE_DIRTY 1
+#define ARPRA_RANGE_UPDATING 2
+
 // Min-Range approximation.
 //#define ARPRA_MIN_RANGE 1
 
 // Temp buffers.
 #define ARPRA_BUFFER_RESIZE_FACTOR 256
 
+// Dense affine vector column block size.
+#define ARPRA_DENSE_BLOCK 64
+
+// Ranges with at most this many terms use pooled term blocks.
+#define ARPRA_SMALL_TERMS 4
+
+// Maximum number of free small term blocks kept per thread.
+#define ARPRA_TERM_POOL_SIZE 256
+
+// Rounding errors smaller than 2^-ARPRA_RNDERR_WINDOW times the largest
+// one seen by an arpra_rnderr accumulator are rounded up to that size.
+#define ARPRA_RNDERR_WINDOW 24
+
+// Largest limb count with a fixed-size multiplication kernel.
+#define ARPRA_FIXED_LIMBS 4
+
+// Default number of threads.
+#define ARPRA_DEFAULT_THREADS 1
+
+// Largest noise symbol.
+#if ARPRA_SYMBOL_32
+#define ARPRA_SYMBOL_MAX UINT32_MAX
+#else
+#define ARPRA_SYMBOL_MAX ULONG_MAX
+#endif
+
+// Noise symbol class, stored in the low bits of each symbol.
+#define ARPRA_SYMBOL_CLASS_BITS 2
+#define ARPRA_SYMBOL_CLASS_MASK ((1UL << ARPRA_SYMBOL_CLASS_BITS) - 1)
+#define ARPRA_SYMBOL_CLASS(symbol) ((arpra_symbol_class) ((symbol) & ARPRA_SYMBOL_CLASS_MASK))
+
+// Default noise symbol classes.
+#define ARPRA_DEFAULT_SYMBOL_CLASS ARPRA_SYMBOL_INPUT
+#define ARPRA_DEFAULT_REDUCE_CLASSES 0xF
+
+// Thread-local storage.
+#if defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L)
+#define ARPRA_THREAD_LOCAL _Thread_local
+#else
+#define ARPRA_THREAD_LOCAL __thread
+#endif
+
+// Parallel task function.
+typedef void (*arpra_helper_task) (void *arg, arpra_uint i);
+
+// Rounding error accumulator, bounding a sum of rounding errors by count * 2^exp.
+typedef struct arpra_rnderr_struct arpra_rnderr;
+struct arpra_rnderr_struct
+{
+    mpfr_exp_t exp;
+    unsigned long count;
+};
+
+// Block floating-point accumulator, bounding a sum of absolute values by sum * 2^exp.
+typedef struct arpra_sumabs_struct arpra_sumabs;
+struct arpra_sumabs_struct
+{
+    mpfr_exp_t exp;
+    uint64_t sum;
+    int nan;
+    int inf;
+};
+
 // Internal auxiliary functions.
 
 
@@ -72,17 +158,60 @@ void arpra_helper_term_fmmaa (mpfr_ptr error, mpfr_ptr y, mpfr_srcptr x1, mpfr_s
 
 
 void arpra_helper_mpfr_rnderr (mpfr_ptr err, mpfr_rnd_t rnd, mpfr_srcptr y);
+void arpra_helper_rnderr_init (arpra_rnderr *acc);
+void arpra_helper_rnderr_add (arpra_rnderr *acc, mpfr_rnd_t rnd, mpfr_srcptr y);
+void arpra_helper_rnderr_get (mpfr_ptr err, const arpra_rnderr *acc);
+arpra_prec arpra_helper_deviation_precision (const arpra_range *y);
+arpra_prec arpra_helper_range_precision (const arpra_range *x1);
+arpra_prec arpra_helper_op_precision (arpra_prec prec, const arpra_range *y, const arpra_range *x1);
+arpra_prec arpra_helper_push_precision (arpra_prec prec);
+void arpra_helper_pop_precision (arpra_prec prev);
 void arpra_helper_compute_range (arpra_range *y);
+void arpra_helper_defer_range (arpra_range *y, mpfi_srcptr ia_range);
+void arpra_helper_update_range (const arpra_range *x1);
+void arpra_helper_sumabs_init (arpra_sumabs *acc);
+void arpra_helper_sumabs_add (arpra_sumabs *acc, mpfr_srcptr x);
+void arpra_helper_sumabs_get (mpfr_ptr y, const arpra_sumabs *acc);
+void arpra_helper_block_sumabs (mpfr_ptr y, mpfr_srcptr x, arpra_uint n);
 void arpra_helper_mix_trim (arpra_range *y, mpfi_srcptr ia_range);
+void arpra_helper_mix_trim_keep_terms (arpra_range *y, mpfi_srcptr ia_range);
+int arpra_helper_adaptive_collapse (arpra_range *y);
+arpra_range_method arpra_helper_range_method (const arpra_range *y);
+void arpra_helper_set_mpfi (arpra_range *y, mpfi_srcptr x1, arpra_symbol_class class);
+void arpra_helper_ia_1 (arpra_range *y, int (*fn) (mpfi_ptr y, mpfi_srcptr x1),
+                        const arpra_range *x1);
+void arpra_helper_ia_2 (arpra_range *y, int (*fn) (mpfi_ptr y, mpfi_srcptr x1, mpfi_srcptr x2),
+                        const arpra_range *x1, const arpra_range *x2);
 void arpra_helper_check_result (arpra_range *y);
 void arpra_helper_set_symbol_count (arpra_uint n);
 arpra_uint arpra_helper_get_symbol_count ();
-arpra_uint arpra_helper_next_symbol ();
+arpra_symbol arpra_helper_next_symbol (arpra_symbol_class class);
+int arpra_helper_reducible_p (arpra_symbol symbol);
+void arpra_helper_set_reduce_classes_local (unsigned int classes);
+void arpra_helper_set_symbol_local (arpra_uint *counter, arpra_uint end);
 mpfr_ptr *arpra_helper_buffer_mpfr_ptr (arpra_uint n);
 mpfr_ptr arpra_helper_buffer_mpfr (arpra_uint n);
+arpra_range *arpra_helper_buffer_range ();
+void arpra_helper_clear_buffers ();
+void arpra_helper_alloc_terms (arpra_range *y, arpra_uint n);
+void arpra_helper_free_terms (arpra_range *y);
+void arpra_helper_clear_term_pool ();
 void arpra_helper_clear_terms (arpra_range *y);
+void arpra_helper_share_terms (arpra_range *y, const arpra_range *x1);
+void arpra_helper_own_terms (arpra_range *y);
+void arpra_helper_dense_alloc (arpra_dense *y, arpra_uint cols);
+void arpra_helper_parallel_for (arpra_helper_task fn, void *arg, arpra_uint n, arpra_uint workers,
+                                arpra_range **y, arpra_uint grps, const arpra_uint *dims);
+arpra_uint arpra_helper_get_worker ();
+void arpra_helper_clear_pool ();
+void arpra_helper_ode_f (arpra_ode_stepper *stepper, arpra_range **dxdt,
+                         const arpra_range *t, const arpra_range **x);
+void arpra_helper_ode_sum (arpra_ode_stepper *stepper, arpra_range **y, arpra_range **x,
+                           const arpra_range *a, arpra_range ***k, arpra_uint n);
+void arpra_helper_ode_reduce (arpra_ode_stepper *stepper, arpra_range **x, int stage);
 
 // Arpra extensions to the MPFR library.
+int arpra_ext_mpfr_mul (mpfr_ptr y, mpfr_srcptr x1, mpfr_srcptr x2, mpfr_rnd_t rnd);
 int arpra_ext_mpfr_fmma (mpfr_ptr y, mpfr_srcptr x1, mpfr_srcptr x2,
                          mpfr_srcptr x3, mpfr_srcptr x4, mpfr_rnd_t rnd);
 int arpra_ext_mpfr_fmmaa (mpfr_ptr y, mpfr_srcptr x1, mpfr_srcptr x2,
@@ -92,6 +221,23 @@ int arpra_ext_mpfr_sum (mpfr_ptr y, mpfr_ptr x,
 int arpra_ext_mpfr_sumabs (mpfr_ptr y, mpfr_ptr x,
                            const arpra_uint n, const mpfr_rnd_t rnd);
 
+// Merge steps: the next term of a merge of x1 and x2 comes from x1, x2 or both.
+#define ARPRA_MERGE_X1 1
+#define ARPRA_MERGE_X2 2
+#define ARPRA_MERGE_BOTH 3
+
+#define ARPRA_MERGE_STEP(x1, i_x1, x2, i_x2)                            \
+    (((i_x2) == (x2)->nTerms) ? ARPRA_MERGE_X1 :                        \
+     ((i_x1) == (x1)->nTerms) ? ARPRA_MERGE_X2 :                        \
+     ((x1)->symbols[i_x1] < (x2)->symbols[i_x2]) ? ARPRA_MERGE_X1 :     \
+     ((x2)->symbols[i_x2] < (x1)->symbols[i_x1]) ? ARPRA_MERGE_X2 :     \
+     ARPRA_MERGE_BOTH)
+
+// Add |dev| to the radius accumulator r, rounding upward.
+#define ARPRA_RADIUS_ADD(r, dev)                                        \
+    ((mpfr_sgn(dev) < 0) ? mpfr_sub((r), (r), (dev), MPFR_RNDU)         \
+                         : mpfr_add((r), (r), (dev), MPFR_RNDU))
+
 // arpra_helper_mpfr_rnderr function wrapper macros.
 #define ARPRA_MPFR_RNDERR(err, rnd, fn, y, ...)                         \
     if (fn(y, __VA_ARGS__, rnd)) arpra_helper_mpfr_rnderr(err, rnd, y)
@@ -106,7 +252,7 @@ int arpra_ext_mpfr_sumabs (mpfr_ptr y, mpfr_ptr x,
     if (mpfr_sub(y, x1, x2, rnd)) arpra_helper_mpfr_rnderr(err, rnd, y)
 
 #define ARPRA_MPFR_RNDERR_MUL(err, rnd, y, x1, x2)                      \
-    if (mpfr_mul(y, x1, x2, rnd)) arpra_helper_mpfr_rnderr(err, rnd, y)
+    if (arpra_ext_mpfr_mul(y, x1, x2, rnd)) arpra_helper_mpfr_rnderr(err, rnd, y)
 
 #define ARPRA_MPFR_RNDERR_FMA(err, rnd, y, x1, x2, x3)                  \
     if (mpfr_fma(y, x1, x2, x3, rnd)) arpra_helper_mpfr_rnderr(err, rnd, y)
@@ -120,4 +266,23 @@ int arpra_ext_mpfr_sumabs (mpfr_ptr y, mpfr_ptr x,
 #define ARPRA_MPFR_RNDERR_SUM(err, rnd, y, x, n)                        \
     if (mpfr_sum(y, x, n, rnd)) arpra_helper_mpfr_rnderr(err, rnd, y)
 
+// arpra_helper_rnderr_add function wrapper macros.
+#define ARPRA_MPFR_RNDACC(acc, rnd, fn, y, ...)                         \
+    if (fn(y, __VA_ARGS__, rnd)) arpra_helper_rnderr_add(acc, rnd, y)
+
+#define ARPRA_MPFR_RNDACC_SET(acc, rnd, y, x1)                          \
+    if (mpfr_set(y, x1, rnd)) arpra_helper_rnderr_add(acc, rnd, y)
+
+#define ARPRA_MPFR_RNDACC_MUL(acc, rnd, y, x1, x2)                      \
+    if (arpra_ext_mpfr_mul(y, x1, x2, rnd)) arpra_helper_rnderr_add(acc, rnd, y)
+
+#define ARPRA_MPFR_RNDACC_FMA(acc, rnd, y, x1, x2, x3)                  \
+    if (mpfr_fma(y, x1, x2, x3, rnd)) arpra_helper_rnderr_add(acc, rnd, y)
+
+#define ARPRA_MPFR_RNDACC_FMMA(acc, rnd, y, x1, x2, x3, x4)             \
+    if (arpra_ext_mpfr_fmma(y, x1, x2, x3, x4, rnd)) arpra_helper_rnderr_add(acc, rnd, y)
+
+#define ARPRA_MPFR_RNDACC_SUM(acc, rnd, y, x, n)                        \
+    if (mpfr_sum(y, x, n, rnd)) arpra_helper_rnderr_add(acc, rnd, y)
+
 #endif // ARPRA_IMPL_H
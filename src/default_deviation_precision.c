@@ -0,0 +1,35 @@
+/*
+ * default_deviation_precision.c -- Get and set the default deviation precision.
+ *
+ * Copyright 2016-2020 James Paul Turner.
+ *
+ * This file is part of the Arpra library.
+ *
+ * The Arpra library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Arpra library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with the Arpra library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "arpra-impl.h"
+
+static arpra_prec default_deviation_precision = ARPRA_DEFAULT_DEVIATION_PRECISION;
+
+arpra_prec arpra_get_default_deviation_precision ()
+{
+    return default_deviation_precision;
+}
+
+void arpra_set_default_deviation_precision (arpra_prec prec)
+{
+    default_deviation_precision = prec;
+}
@@ -0,0 +1,305 @@
+/*
+ * dense.c -- Dense affine vectors, and conversion to and from ranges.
+ *
+ * Copyright 2016-2020 James Paul Turner.
+ *
+ * This file is part of the Arpra library.
+ *
+ * The Arpra library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Arpra library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with the Arpra library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "arpra-impl.h"
+
+void arpra_dense_init (arpra_dense *y, arpra_uint rows)
+{
+    arpra_prec prec;
+
+    prec = arpra_get_default_precision();
+    arpra_dense_init2(y, rows, prec);
+}
+
+void arpra_dense_init2 (arpra_dense *y, arpra_uint rows, arpra_prec prec)
+{
+    arpra_prec prec_internal;
+    arpra_uint i;
+
+    prec_internal = arpra_get_internal_precision();
+    y->precision = prec;
+    y->rows = rows;
+    y->cols = 0;
+    y->basis = NULL;
+    y->deviations = NULL;
+    y->centre = malloc(rows * sizeof(mpfr_t));
+    y->error = malloc(rows * sizeof(mpfr_t));
+    for (i = 0; i < rows; i++) {
+        mpfr_init2(&(y->centre[i]), prec_internal);
+        mpfr_init2(&(y->error[i]), prec_internal);
+        mpfr_set_zero(&(y->centre[i]), 1);
+        mpfr_set_zero(&(y->error[i]), 1);
+    }
+}
+
+void arpra_dense_clear (arpra_dense *y)
+{
+    arpra_uint i;
+
+    for (i = 0; i < y->rows; i++) {
+        mpfr_clear(&(y->centre[i]));
+        mpfr_clear(&(y->error[i]));
+    }
+    for (i = 0; i < (y->rows * y->cols); i++) {
+        mpfr_clear(&(y->deviations[i]));
+    }
+    free(y->centre);
+    free(y->error);
+    free(y->basis);
+    free(y->deviations);
+}
+
+/*
+ * Give y a basis of cols symbols, with zero deviations. The basis symbols
+ * are left for the caller to fill.
+ */
+
+void arpra_helper_dense_alloc (arpra_dense *y, arpra_uint cols)
+{
+    arpra_prec prec_internal;
+    arpra_uint i;
+
+    prec_internal = arpra_get_internal_precision();
+    for (i = 0; i < (y->rows * y->cols); i++) {
+        mpfr_clear(&(y->deviations[i]));
+    }
+    free(y->basis);
+    free(y->deviations);
+    y->cols = cols;
+    y->basis = malloc(cols * sizeof(arpra_symbol));
+    y->deviations = malloc(y->rows * cols * sizeof(mpfr_t));
+    for (i = 0; i < (y->rows * cols); i++) {
+        mpfr_init2(&(y->deviations[i]), prec_internal);
+        mpfr_set_zero(&(y->deviations[i]), 1);
+    }
+}
+
+static int symbol_cmp (const void *a, const void *b)
+{
+    arpra_symbol sa = *((const arpra_symbol *) a);
+    arpra_symbol sb = *((const arpra_symbol *) b);
+
+    return (sa > sb) - (sa < sb);
+}
+
+static void dense_set (arpra_dense *y, const arpra_range **x)
+{
+    mpfr_t error;
+    arpra_rnderr rnderr;
+    arpra_symbol *symbols;
+    arpra_prec prec_internal;
+    arpra_uint i, i_x, j, m;
+
+    // Initialise vars.
+    prec_internal = arpra_get_internal_precision();
+    mpfr_init2(error, prec_internal);
+
+    // The basis is the union of all symbols.
+    for (i = 0, m = 0; i < y->rows; i++) {
+        m += x[i]->nTerms;
+    }
+    symbols = malloc(m * sizeof(arpra_symbol));
+    for (i = 0, m = 0; i < y->rows; i++) {
+        for (i_x = 0; i_x < x[i]->nTerms; i_x++) {
+            symbols[m++] = x[i]->symbols[i_x];
+        }
+    }
+    qsort(symbols, m, sizeof(arpra_symbol), &symbol_cmp);
+    for (i = 0, j = 0; i < m; i++) {
+        if ((j == 0) || (symbols[i] != symbols[j - 1])) {
+            symbols[j++] = symbols[i];
+        }
+    }
+    arpra_helper_dense_alloc(y, j);
+    for (j = 0; j < y->cols; j++) {
+        y->basis[j] = symbols[j];
+    }
+
+    for (i = 0; i < y->rows; i++) {
+        mpfr_set_zero(error, 1);
+        arpra_helper_rnderr_init(&rnderr);
+
+        // Handle domain violations.
+        if (arpra_nan_p(x[i])) {
+            mpfr_set_nan(&(y->centre[i]));
+            mpfr_set_zero(&(y->error[i]), 1);
+            continue;
+        }
+        if (arpra_inf_p(x[i])) {
+            mpfr_set_zero(&(y->centre[i]), 1);
+            mpfr_set_inf(&(y->error[i]), 1);
+            continue;
+        }
+
+        // y[0] = x[0]
+        ARPRA_MPFR_RNDERR_SET(error, MPFR_RNDN, &(y->centre[i]), &(x[i]->centre));
+
+        // y[i] = x[i]
+        for (i_x = 0, j = 0; i_x < x[i]->nTerms; i_x++) {
+            while (y->basis[j] != x[i]->symbols[i_x]) {
+                j++;
+            }
+            ARPRA_MPFR_RNDACC_SET(&rnderr, MPFR_RNDN, &(y->deviations[i * y->cols + j]), &(x[i]->deviations[i_x]));
+        }
+
+        arpra_helper_rnderr_get(error, &rnderr);
+        mpfr_set(&(y->error[i]), error, MPFR_RNDU);
+    }
+
+    // Clear vars.
+    mpfr_clear(error);
+    free(symbols);
+}
+
+static void dense_get (arpra_range **y, const arpra_dense *x)
+{
+    mpfr_t error;
+    arpra_rnderr rnderr;
+    arpra_range yy;
+    arpra_prec prec_internal, prec_deviation;
+    arpra_uint i, i_y, j;
+
+    // Initialise vars.
+    prec_internal = arpra_get_internal_precision();
+    mpfr_init2(error, prec_internal);
+
+    for (i = 0; i < x->rows; i++) {
+        arpra_init2(&yy, y[i]->precision);
+        yy.deviation_precision = y[i]->deviation_precision;
+        yy.internal_precision = y[i]->internal_precision;
+        yy.range_method = y[i]->range_method;
+        prec_deviation = arpra_helper_deviation_precision(y[i]);
+
+        // Handle domain violations.
+        if (mpfr_nan_p(&(x->centre[i])) || mpfr_nan_p(&(x->error[i]))) {
+            arpra_set_nan(&yy);
+        }
+        else if (mpfr_inf_p(&(x->centre[i])) || mpfr_inf_p(&(x->error[i]))) {
+            arpra_set_inf(&yy);
+        }
+        else {
+            mpfr_set(error, &(x->error[i]), MPFR_RNDU);
+            mpfr_set_zero(&(yy.radius), 1);
+            arpra_helper_rnderr_init(&rnderr);
+
+            // y[0] = x[0]
+            ARPRA_MPFR_RNDERR_SET(error, MPFR_RNDN, &(yy.centre), &(x->centre[i]));
+
+            // Allocate memory for deviation terms.
+            arpra_helper_alloc_terms(&yy, x->cols + 1);
+
+            // y[i] = x[i], for non-zero x[i]
+            for (i_y = 0, j = 0; j < x->cols; j++) {
+                if (!mpfr_zero_p(&(x->deviations[i * x->cols + j]))) {
+                    mpfr_init2(&(yy.deviations[i_y]), prec_deviation);
+                    yy.symbols[i_y] = x->basis[j];
+                    ARPRA_MPFR_RNDACC_SET(&rnderr, MPFR_RNDN, &(yy.deviations[i_y]), &(x->deviations[i * x->cols + j]));
+                    ARPRA_RADIUS_ADD(&(yy.radius), &(yy.deviations[i_y]));
+                    i_y++;
+                }
+            }
+
+            // Store new deviation term.
+            arpra_helper_rnderr_get(error, &rnderr);
+            mpfr_init2(&(yy.deviations[i_y]), prec_internal);
+            yy.symbols[i_y] = arpra_helper_next_symbol(ARPRA_SYMBOL_ROUNDING);
+            mpfr_set(&(yy.deviations[i_y]), error, MPFR_RNDU);
+            ARPRA_RADIUS_ADD(&(yy.radius), &(yy.deviations[i_y]));
+            yy.nTerms = i_y + 1;
+
+            // Compute true_range.
+            arpra_helper_compute_range(&yy);
+
+            // Check for NaN and Inf.
+            arpra_helper_check_result(&yy);
+        }
+
+        // Set y.
+        arpra_clear(y[i]);
+        *y[i] = yy;
+    }
+
+    // Clear vars.
+    mpfr_clear(error);
+}
+
+void arpra_dense_set_range (arpra_dense *y, const arpra_range *x)
+{
+    const arpra_range **x_ptr;
+    arpra_uint i;
+
+    x_ptr = malloc(y->rows * sizeof(arpra_range *));
+    for (i = 0; i < y->rows; i++) {
+        x_ptr[i] = &(x[i]);
+    }
+    dense_set(y, x_ptr);
+    free(x_ptr);
+}
+
+void arpra_dense_get_range (arpra_range *y, const arpra_dense *x)
+{
+    arpra_range **y_ptr;
+    arpra_uint i;
+
+    y_ptr = malloc(x->rows * sizeof(arpra_range *));
+    for (i = 0; i < x->rows; i++) {
+        y_ptr[i] = &(y[i]);
+    }
+    dense_get(y_ptr, x);
+    free(y_ptr);
+}
+
+/*
+ * The rows of an ODE state vector are its groups in order, and the
+ * dimensions of each group in order. y must have as many rows as the
+ * system has state variables.
+ */
+
+void arpra_dense_set_ode_state (arpra_dense *y, const arpra_ode_system *system)
+{
+    const arpra_range **x_ptr;
+    arpra_uint x_grp, x_dim, i;
+
+    x_ptr = malloc(y->rows * sizeof(arpra_range *));
+    for (x_grp = 0, i = 0; x_grp < system->grps; x_grp++) {
+        for (x_dim = 0; x_dim < system->dims[x_grp]; x_dim++) {
+            x_ptr[i++] = &(system->x[x_grp][x_dim]);
+        }
+    }
+    dense_set(y, x_ptr);
+    free(x_ptr);
+}
+
+void arpra_dense_get_ode_state (arpra_ode_system *system, const arpra_dense *x)
+{
+    arpra_range **y_ptr;
+    arpra_uint x_grp, x_dim, i;
+
+    y_ptr = malloc(x->rows * sizeof(arpra_range *));
+    for (x_grp = 0, i = 0; x_grp < system->grps; x_grp++) {
+        for (x_dim = 0; x_dim < system->dims[x_grp]; x_dim++) {
+            y_ptr[i++] = &(system->x[x_grp][x_dim]);
+        }
+    }
+    dense_get(y_ptr, x);
+    free(y_ptr);
+}
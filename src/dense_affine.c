@@ -0,0 +1,259 @@
+/*
+ * dense_affine.c -- Affine operations on dense affine vectors.
+ *
+ * Copyright 2016-2020 James Paul Turner.
+ *
+ * This file is part of the Arpra library.
+ *
+ * The Arpra library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Arpra library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with the Arpra library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "arpra-impl.h"
+
+/*
+ * Give y the union of the bases of x1 and x2, and find the column of each
+ * union symbol in x1 and x2, or x->cols if it is not there.
+ */
+
+static void dense_align (arpra_dense *y, arpra_uint *col1, arpra_uint *col2,
+                         const arpra_dense *x1, const arpra_dense *x2)
+{
+    arpra_uint j, j1, j2;
+
+    for (j = 0, j1 = 0, j2 = 0; (j1 < x1->cols) || (j2 < x2->cols); j++) {
+        if ((j2 == x2->cols) || ((j1 < x1->cols) && (x1->basis[j1] < x2->basis[j2]))) {
+            j1++;
+        }
+        else if ((j1 == x1->cols) || (x2->basis[j2] < x1->basis[j1])) {
+            j2++;
+        }
+        else {
+            j1++;
+            j2++;
+        }
+    }
+    arpra_helper_dense_alloc(y, j);
+
+    for (j = 0, j1 = 0, j2 = 0; j < y->cols; j++) {
+        if ((j2 == x2->cols) || ((j1 < x1->cols) && (x1->basis[j1] < x2->basis[j2]))) {
+            y->basis[j] = x1->basis[j1];
+            col1[j] = j1++;
+            col2[j] = x2->cols;
+        }
+        else if ((j1 == x1->cols) || (x2->basis[j2] < x1->basis[j1])) {
+            y->basis[j] = x2->basis[j2];
+            col1[j] = x1->cols;
+            col2[j] = j2++;
+        }
+        else {
+            y->basis[j] = x1->basis[j1];
+            col1[j] = j1++;
+            col2[j] = j2++;
+        }
+    }
+}
+
+/*
+ * y = (a * x1) + x2, or (a * x1) - x2 if sub is set. Each deviation is
+ * rounded once, and the rounding errors of row i go to y->error[i].
+ */
+
+static void dense_axpy (arpra_dense *y, mpfr_srcptr a, const arpra_dense *x1,
+                        const arpra_dense *x2, int sub)
+{
+    mpfr_t temp;
+    arpra_dense yy;
+    arpra_prec prec_internal;
+    arpra_uint *col1, *col2, i, j;
+    mpfr_ptr y_i, error;
+    mpfr_srcptr x1_i, x2_i;
+    arpra_rnderr rnderr;
+
+    // Initialise vars.
+    prec_internal = arpra_get_internal_precision();
+    mpfr_init2(temp, prec_internal);
+    arpra_dense_init2(&yy, y->rows, y->precision);
+    col1 = malloc((x1->cols + x2->cols) * sizeof(arpra_uint));
+    col2 = malloc((x1->cols + x2->cols) * sizeof(arpra_uint));
+    dense_align(&yy, col1, col2, x1, x2);
+
+    for (i = 0; i < yy.rows; i++) {
+        y_i = &(yy.deviations[i * yy.cols]);
+        x1_i = &(x1->deviations[i * x1->cols]);
+        x2_i = &(x2->deviations[i * x2->cols]);
+        error = &(yy.error[i]);
+        arpra_helper_rnderr_init(&rnderr);
+
+        // error = |a| x1_error + x2_error
+        mpfr_abs(temp, a, MPFR_RNDU);
+        mpfr_mul(error, temp, &(x1->error[i]), MPFR_RNDU);
+        mpfr_add(error, error, &(x2->error[i]), MPFR_RNDU);
+
+        // y[0] = (a * x1[0]) +/- x2[0]
+        if (sub) {
+            ARPRA_MPFR_RNDERR(error, MPFR_RNDN, mpfr_fms, &(yy.centre[i]), a, &(x1->centre[i]), &(x2->centre[i]));
+        }
+        else {
+            ARPRA_MPFR_RNDERR_FMA(error, MPFR_RNDN, &(yy.centre[i]), a, &(x1->centre[i]), &(x2->centre[i]));
+        }
+
+        for (j = 0; j < yy.cols; j++) {
+            if (col2[j] == x2->cols) {
+                // y[j] = a * x1[j]
+                ARPRA_MPFR_RNDACC_MUL(&rnderr, MPFR_RNDN, &(y_i[j]), a, &(x1_i[col1[j]]));
+            }
+            else if (col1[j] == x1->cols) {
+                // y[j] = +/- x2[j]
+                if (sub) {
+                    ARPRA_MPFR_RNDACC(&rnderr, MPFR_RNDN, mpfr_neg, &(y_i[j]), &(x2_i[col2[j]]));
+                }
+                else {
+                    ARPRA_MPFR_RNDACC_SET(&rnderr, MPFR_RNDN, &(y_i[j]), &(x2_i[col2[j]]));
+                }
+            }
+            else if (sub) {
+                // y[j] = (a * x1[j]) - x2[j]
+                ARPRA_MPFR_RNDACC(&rnderr, MPFR_RNDN, mpfr_fms, &(y_i[j]), a, &(x1_i[col1[j]]), &(x2_i[col2[j]]));
+            }
+            else {
+                // y[j] = (a * x1[j]) + x2[j]
+                ARPRA_MPFR_RNDACC_FMA(&rnderr, MPFR_RNDN, &(y_i[j]), a, &(x1_i[col1[j]]), &(x2_i[col2[j]]));
+            }
+        }
+
+        // Rounding error.
+        arpra_helper_rnderr_get(error, &rnderr);
+    }
+
+    // Clear vars, and set y.
+    mpfr_clear(temp);
+    free(col1);
+    free(col2);
+    arpra_dense_clear(y);
+    *y = yy;
+}
+
+void arpra_dense_add (arpra_dense *y, const arpra_dense *x1, const arpra_dense *x2)
+{
+    mpfr_t one;
+
+    mpfr_init2(one, 2);
+    mpfr_set_si(one, 1, MPFR_RNDN);
+    dense_axpy(y, one, x1, x2, 0);
+    mpfr_clear(one);
+}
+
+void arpra_dense_sub (arpra_dense *y, const arpra_dense *x1, const arpra_dense *x2)
+{
+    mpfr_t one;
+
+    mpfr_init2(one, 2);
+    mpfr_set_si(one, 1, MPFR_RNDN);
+    dense_axpy(y, one, x1, x2, 1);
+    mpfr_clear(one);
+}
+
+void arpra_dense_axpy (arpra_dense *y, mpfr_srcptr a, const arpra_dense *x1, const arpra_dense *x2)
+{
+    dense_axpy(y, a, x1, x2, 0);
+}
+
+/*
+ * y = (a * x1) + b, where a is a y->rows by x1->rows matrix. Columns are
+ * processed in blocks of ARPRA_DENSE_BLOCK, so that a block of each row of
+ * x1 stays in cache while it is accumulated into every row of y.
+ */
+
+void arpra_dense_affine (arpra_dense *y, mpfr_srcptr a, const arpra_dense *x1, mpfr_srcptr b)
+{
+    mpfr_t temp;
+    arpra_dense yy;
+    arpra_prec prec_internal;
+    arpra_uint i, k, j, j_start, j_end;
+    mpfr_srcptr a_ik;
+    arpra_rnderr *rnderr;
+
+    // Initialise vars.
+    prec_internal = arpra_get_internal_precision();
+    mpfr_init2(temp, prec_internal);
+    arpra_dense_init2(&yy, y->rows, y->precision);
+    arpra_helper_dense_alloc(&yy, x1->cols);
+    rnderr = malloc(yy.rows * sizeof(arpra_rnderr));
+    for (j = 0; j < yy.cols; j++) {
+        yy.basis[j] = x1->basis[j];
+    }
+
+    for (i = 0; i < yy.rows; i++) {
+        arpra_helper_rnderr_init(&(rnderr[i]));
+
+        // y[0] = b
+        if (b != NULL) {
+            ARPRA_MPFR_RNDERR_SET(&(yy.error[i]), MPFR_RNDN, &(yy.centre[i]), &(b[i]));
+        }
+
+        for (k = 0; k < x1->rows; k++) {
+            a_ik = &(a[i * x1->rows + k]);
+            if (mpfr_zero_p(a_ik)) {
+                continue;
+            }
+
+            // error += |a[i][k]| x1_error[k]
+            mpfr_abs(temp, a_ik, MPFR_RNDU);
+            mpfr_mul(temp, temp, &(x1->error[k]), MPFR_RNDU);
+            mpfr_add(&(yy.error[i]), &(yy.error[i]), temp, MPFR_RNDU);
+
+            // y[0] += a[i][k] * x1[0]
+            ARPRA_MPFR_RNDERR_FMA(&(yy.error[i]), MPFR_RNDN, &(yy.centre[i]),
+                                  a_ik, &(x1->centre[k]), &(yy.centre[i]));
+        }
+    }
+
+    for (j_start = 0; j_start < yy.cols; j_start += ARPRA_DENSE_BLOCK) {
+        j_end = j_start + ARPRA_DENSE_BLOCK;
+        if (j_end > yy.cols) {
+            j_end = yy.cols;
+        }
+
+        for (i = 0; i < yy.rows; i++) {
+            for (k = 0; k < x1->rows; k++) {
+                a_ik = &(a[i * x1->rows + k]);
+                if (mpfr_zero_p(a_ik)) {
+                    continue;
+                }
+
+                // y[j] += a[i][k] * x1[j]
+                for (j = j_start; j < j_end; j++) {
+                    if (mpfr_zero_p(&(x1->deviations[k * x1->cols + j]))) {
+                        continue;
+                    }
+                    ARPRA_MPFR_RNDACC_FMA(&(rnderr[i]), MPFR_RNDN, &(yy.deviations[i * yy.cols + j]),
+                                          a_ik, &(x1->deviations[k * x1->cols + j]),
+                                          &(yy.deviations[i * yy.cols + j]));
+                }
+            }
+        }
+    }
+
+    // Rounding error.
+    for (i = 0; i < yy.rows; i++) {
+        arpra_helper_rnderr_get(&(yy.error[i]), &(rnderr[i]));
+    }
+
+    // Clear vars, and set y.
+    mpfr_clear(temp);
+    free(rnderr);
+    arpra_dense_clear(y);
+    *y = yy;
+}
@@ -0,0 +1,50 @@
+/*
+ * deviation_precision.c -- Get and set the deviation precision of an Arpra range.
+ *
+ * Copyright 2016-2020 James Paul Turner.
+ *
+ * This file is part of the Arpra library.
+ *
+ * The Arpra library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Arpra library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with the Arpra library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "arpra-impl.h"
+
+/*
+ * The deviation precision of a range is the precision of the deviation
+ * coefficients computed into it, while its centre keeps the internal
+ * precision. Coefficients are rounded to nearest, and the rounding error
+ * goes into the new error term, as for any other rounded term. Zero means
+ * the internal precision. Error terms always keep the internal precision.
+ */
+
+arpra_prec arpra_get_deviation_precision (const arpra_range *x1)
+{
+    return x1->deviation_precision;
+}
+
+void arpra_set_deviation_precision (arpra_range *y, arpra_prec prec)
+{
+    y->deviation_precision = prec;
+}
+
+arpra_prec arpra_helper_deviation_precision (const arpra_range *y)
+{
+    if (y->deviation_precision == 0) {
+        return arpra_get_internal_precision();
+    }
+
+    return y->deviation_precision;
+}
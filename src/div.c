@@ -51,9 +51,16 @@ void arpra_div (arpra_range *y, const arpra_range *x1, const arpra_range *x2)
         return;
     }
 
+    // Interval method.
+    if (arpra_helper_range_method(y) == ARPRA_IA) {
+        arpra_helper_ia_2(y, mpfi_div, x1, x2);
+        return;
+    }
+
     // Initialise vars.
     mpfi_init2(ia_range, y->precision);
     arpra_init2(&yy, y->precision);
+    yy.range_method = y->range_method;
 
     // MPFI division
     mpfi_div(ia_range, &(x1->true_range), &(x2->true_range));
@@ -21,10 +21,13 @@
 
 #include "arpra-impl.h"
 
-// TODO: USE MPFR 4 FMMA
 int arpra_ext_mpfr_fmma (mpfr_ptr y, mpfr_srcptr x1, mpfr_srcptr x2,
                          mpfr_srcptr x3, mpfr_srcptr x4, mpfr_rnd_t rnd)
 {
+#if MPFR_VERSION_MAJOR >= 4
+    // MPFR 4 rounds (x1 * x2) + (x3 * x4) once, without exact temporaries.
+    return mpfr_fmma(y, x1, x2, x3, x4, rnd);
+#else
     mpfr_t x1x2, x3x4;
     int ternary;
 
@@ -44,6 +47,7 @@ int arpra_ext_mpfr_fmma (mpfr_ptr y, mpfr_srcptr x1, mpfr_srcptr x2,
     mpfr_clear(x3x4);
 
     return ternary;
+#endif // MPFR_VERSION_MAJOR
 }
 
 // TOOD: use MPFR 4 SUM SYNTAX
@@ -0,0 +1,113 @@
+/*
+ * ext_mpfr_mul.c -- Fixed limb count MPFR multiplication.
+ *
+ * Copyright 2018-2020 James Paul Turner.
+ *
+ * This file is part of the Arpra library.
+ *
+ * The Arpra library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Arpra library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with the Arpra library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "arpra-impl.h"
+
+#define ARPRA_LIMB_HIGHBIT ((mp_limb_t) 1 << (GMP_NUMB_BITS - 1))
+
+/*
+ * Round-to-nearest product of regular numbers whose significands are all
+ * exactly n limbs. The n argument is a constant at each call site, so the
+ * loops below are unrolled. Returns 2 if the result exponent is out of
+ * range, in which case y is left untouched.
+ */
+static inline int mul_fixed (mpfr_ptr y, mpfr_srcptr x1, mpfr_srcptr x2, const mp_size_t n)
+{
+    mp_limb_t p[2 * ARPRA_FIXED_LIMBS];
+    mp_limb_t round, sticky;
+    mpfr_exp_t exp;
+    mp_size_t i;
+    int sign, ternary;
+
+    // The exact product has 2n limbs, with at most one leading zero bit.
+    mpn_mul_n(p, x1->_mpfr_d, x2->_mpfr_d, n);
+    exp = x1->_mpfr_exp + x2->_mpfr_exp;
+    if (!(p[2 * n - 1] & ARPRA_LIMB_HIGHBIT)) {
+        mpn_lshift(p, p, 2 * n, 1);
+        exp--;
+    }
+
+    // The low n limbs hold the round bit and the sticky bits.
+    round = p[n - 1] & ARPRA_LIMB_HIGHBIT;
+    sticky = p[n - 1] & ~ARPRA_LIMB_HIGHBIT;
+    for (i = 0; i < n - 1; i++) {
+        sticky |= p[i];
+    }
+
+    // Round to nearest, ties to even.
+    if (round && (sticky || (p[n] & 1))) {
+        if (mpn_add_1(p + n, p + n, n, 1)) {
+            p[2 * n - 1] = ARPRA_LIMB_HIGHBIT;
+            exp++;
+        }
+        ternary = 1;
+    }
+    else {
+        ternary = (round || sticky) ? -1 : 0;
+    }
+
+    // Leave overflow and underflow to MPFR.
+    if ((exp <= mpfr_get_emin()) || (exp >= mpfr_get_emax())) {
+        return 2;
+    }
+
+    for (i = 0; i < n; i++) {
+        y->_mpfr_d[i] = p[n + i];
+    }
+    y->_mpfr_exp = exp;
+    sign = x1->_mpfr_sign * x2->_mpfr_sign;
+    y->_mpfr_sign = sign;
+
+    return sign * ternary;
+}
+
+int arpra_ext_mpfr_mul (mpfr_ptr y, mpfr_srcptr x1, mpfr_srcptr x2, mpfr_rnd_t rnd)
+{
+    mpfr_prec_t prec;
+    int ternary;
+
+    prec = mpfr_get_prec(y);
+
+    // Use a fixed limb count kernel if y, x1 and x2 fill the same number of whole limbs.
+    if ((rnd == MPFR_RNDN) && (prec % GMP_NUMB_BITS == 0)
+        && (mpfr_get_prec(x1) == prec) && (mpfr_get_prec(x2) == prec)
+        && mpfr_regular_p(x1) && mpfr_regular_p(x2)) {
+        switch (prec / GMP_NUMB_BITS) {
+        case 2:
+            ternary = mul_fixed(y, x1, x2, 2);
+            break;
+        case 3:
+            ternary = mul_fixed(y, x1, x2, 3);
+            break;
+        case 4:
+            ternary = mul_fixed(y, x1, x2, 4);
+            break;
+        default:
+            ternary = 2;
+            break;
+        }
+        if (ternary != 2) {
+            return ternary;
+        }
+    }
+
+    return mpfr_mul(y, x1, x2, rnd);
+}
@@ -23,6 +23,7 @@
 
 void arpra_get_bounds (mpfr_ptr y_lo, mpfr_ptr y_hi, const arpra_range *x)
 {
+    arpra_helper_update_range(x);
     mpfr_set(y_lo, &(x->true_range.left), MPFR_RNDD);
     mpfr_set(y_hi, &(x->true_range.right), MPFR_RNDU);
 }
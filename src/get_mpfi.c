@@ -23,5 +23,6 @@
 
 void arpra_get_mpfi (mpfi_ptr y, const arpra_range *x)
 {
+    arpra_helper_update_range(x);
     mpfi_set(y, &(x->true_range));
 }
@@ -25,34 +25,47 @@ void arpra_helper_affine_2 (arpra_range *y, const arpra_range *x1, const arpra_r
                             mpfi_srcptr alpha, mpfi_srcptr beta, mpfi_srcptr gamma, mpfr_srcptr delta)
 {
     mpfr_t temp, error;
+    arpra_sumabs radius;
     arpra_range yy;
-    arpra_prec prec_internal;
+    arpra_prec prec_internal, prec_deviation, prec_op, prec_prev;
     arpra_uint i_y, i_x1, i_x2;
+    unsigned char step;
+
+    // Choose the working precision.
+    prec_op = arpra_helper_op_precision(0, y, x1);
+    prec_op = arpra_helper_op_precision(prec_op, y, x2);
+    prec_prev = arpra_helper_push_precision(prec_op);
 
     // Initialise vars.
     prec_internal = arpra_get_internal_precision();
+    prec_deviation = arpra_helper_deviation_precision(y);
     mpfr_init2(temp, prec_internal);
     mpfr_init2(error, prec_internal);
     arpra_init2(&yy, y->precision);
+    yy.deviation_precision = y->deviation_precision;
+    yy.internal_precision = y->internal_precision;
+    yy.range_method = y->range_method;
+    yy.wide_ops = (x1->wide_ops > x2->wide_ops) ? x1->wide_ops : x2->wide_ops;
     mpfr_set_zero(error, 1);
+    arpra_helper_sumabs_init(&radius);
 
     // y[0] = (alpha * x1[0]) + (beta * x2[0]) + (gamma)
     arpra_helper_term_fmmaa(error, &(yy.centre), &(x1->centre), &(x2->centre), alpha, beta, gamma);
 
     // Allocate memory for deviation terms.
-    yy.symbols = malloc((x1->nTerms + x2->nTerms + 1) * sizeof(arpra_uint));
-    yy.deviations = malloc((x1->nTerms + x2->nTerms + 1) * sizeof(mpfr_t));
+    arpra_helper_alloc_terms(&yy, x1->nTerms + x2->nTerms + 1);
 
     for (i_y = 0, i_x1 = 0, i_x2 = 0; (i_x1 < x1->nTerms) || (i_x2 < x2->nTerms); i_y++) {
-        mpfr_init2(&(yy.deviations[i_y]), prec_internal);
+        mpfr_init2(&(yy.deviations[i_y]), prec_deviation);
+        step = ARPRA_MERGE_STEP(x1, i_x1, x2, i_x2);
 
-        if ((i_x2 == x2->nTerms) || ((i_x1 < x1->nTerms) && (x1->symbols[i_x1] < x2->symbols[i_x2]))) {
+        if (step == ARPRA_MERGE_X1) {
             // y[i] = (alpha * x1[i])
             yy.symbols[i_y] = x1->symbols[i_x1];
             arpra_helper_term_mul(error, &(yy.deviations[i_y]), &(x1->deviations[i_x1]), alpha);
             i_x1++;
         }
-        else if ((i_x1 == x1->nTerms) || ((i_x2 < x2->nTerms) && (x2->symbols[i_x2] < x1->symbols[i_x1]))) {
+        else if (step == ARPRA_MERGE_X2) {
             // y[i] = (beta * x2[i])
             yy.symbols[i_y] = x2->symbols[i_x2];
             arpra_helper_term_mul(error, &(yy.deviations[i_y]), &(x2->deviations[i_x2]), beta);
@@ -65,18 +78,23 @@ void arpra_helper_affine_2 (arpra_range *y, const arpra_range *x1, const arpra_r
             i_x1++;
             i_x2++;
         }
+        arpra_helper_sumabs_add(&radius, &(yy.deviations[i_y]));
     }
 
     // Add delta to error.
     mpfr_add(error, error, delta, MPFR_RNDU);
 
     // Store new deviation term.
-    yy.symbols[i_y] = arpra_helper_next_symbol();
+    yy.symbols[i_y] = arpra_helper_next_symbol((mpfr_zero_p(delta) ? ARPRA_SYMBOL_ROUNDING : ARPRA_SYMBOL_APPROXIMATION));
     yy.deviations[i_y] = *error;
+    arpra_helper_sumabs_add(&radius, &(yy.deviations[i_y]));
+    arpra_helper_sumabs_get(&(yy.radius), &radius);
+    yy.dirty = ARPRA_RANGE_DIRTY;
     yy.nTerms = i_y + 1;
 
     // Clear vars, and set y.
     mpfr_clear(temp);
     arpra_clear(y);
     *y = yy;
+    arpra_helper_pop_precision(prec_prev);
 }
@@ -0,0 +1,71 @@
+/*
+ * helper_alloc_terms.c -- Allocate deviation term storage.
+ *
+ * Copyright 2016-2020 James Paul Turner.
+ *
+ * This file is part of the Arpra library.
+ *
+ * The Arpra library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Arpra library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with the Arpra library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "arpra-impl.h"
+
+/*
+ * Symbols and deviations share one block, with the symbols stored after the
+ * deviations. Blocks for up to ARPRA_SMALL_TERMS terms all have the same
+ * size, and are recycled through a per-thread pool instead of being freed.
+ */
+
+static ARPRA_THREAD_LOCAL void *term_pool[ARPRA_TERM_POOL_SIZE];
+static ARPRA_THREAD_LOCAL arpra_uint term_pool_size = 0;
+
+void arpra_helper_alloc_terms (arpra_range *y, arpra_uint n)
+{
+    void *block;
+
+    if (n <= ARPRA_SMALL_TERMS) {
+        n = ARPRA_SMALL_TERMS;
+        if (term_pool_size > 0) {
+            block = term_pool[--term_pool_size];
+        }
+        else {
+            block = malloc(n * (sizeof(mpfr_t) + sizeof(arpra_symbol)));
+        }
+    }
+    else {
+        block = malloc(n * (sizeof(mpfr_t) + sizeof(arpra_symbol)));
+    }
+
+    y->deviations = block;
+    y->symbols = (arpra_symbol *) (y->deviations + n);
+}
+
+void arpra_helper_free_terms (arpra_range *y)
+{
+    // Any block holding a small range is at least as big as a small block.
+    if ((y->nTerms <= ARPRA_SMALL_TERMS) && (term_pool_size < ARPRA_TERM_POOL_SIZE)) {
+        term_pool[term_pool_size++] = y->deviations;
+    }
+    else {
+        free(y->deviations);
+    }
+}
+
+void arpra_helper_clear_term_pool ()
+{
+    while (term_pool_size > 0) {
+        free(term_pool[--term_pool_size]);
+    }
+}
@@ -0,0 +1,120 @@
+/*
+ * helper_block_sumabs.c -- Bound a sum of absolute values in block floating-point.
+ *
+ * Copyright 2018-2020 James Paul Turner.
+ *
+ * This file is part of the Arpra library.
+ *
+ * The Arpra library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Arpra library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with the Arpra library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "arpra-impl.h"
+
+static inline uint64_t top_bits (mpfr_srcptr x)
+{
+    mp_size_t k;
+
+    // |x| < top_bits(x) * 2^(exp(x) - 63), for the top 63 bits of x plus one.
+    k = (mpfr_get_prec(x) - 1) / GMP_NUMB_BITS;
+#if GMP_NUMB_BITS >= 64
+    return ((uint64_t) (x->_mpfr_d[k] >> (GMP_NUMB_BITS - 63))) + 1;
+#else
+    return ((((uint64_t) x->_mpfr_d[k] << 32) | ((k > 0) ? x->_mpfr_d[k - 1] : 0)) >> 1) + 1;
+#endif
+}
+
+/*
+ * The arpra_sumabs accumulator bounds |x[0]| + ... + |x[n-1]| from above as
+ * terms are generated, so operations can sum their radius in the same loop.
+ * Each term is rounded up to a 63-bit integer mantissa, and then up again to
+ * the unit 2^exp of the running sum. The unit is raised as larger terms
+ * arrive, and the sum is halved before it can overflow, rounding up every
+ * time. The bound exceeds the exact sum by at most about n 2^-61 times the
+ * sum, and each term costs only integer shifts and adds.
+ */
+
+void arpra_helper_sumabs_init (arpra_sumabs *acc)
+{
+    acc->exp = 0;
+    acc->sum = 0;
+    acc->nan = 0;
+    acc->inf = 0;
+}
+
+void arpra_helper_sumabs_add (arpra_sumabs *acc, mpfr_srcptr x)
+{
+    mpfr_exp_t exp, shift;
+    uint64_t m;
+
+    // Leave zeros out, and note NaN and infinity.
+    if (!mpfr_regular_p(x)) {
+        if (mpfr_nan_p(x)) {
+            acc->nan = 1;
+        }
+        else if (mpfr_inf_p(x)) {
+            acc->inf = 1;
+        }
+        return;
+    }
+
+    // |x| < m 2^exp, with m at most 2^63.
+    m = top_bits(x);
+    exp = mpfr_get_exp(x) - 63;
+    if (acc->sum == 0) {
+        acc->exp = exp;
+    }
+
+    // Bring m and the sum to the larger unit, rounding up.
+    if (exp > acc->exp) {
+        shift = exp - acc->exp;
+        acc->sum = (shift < 64) ? (((acc->sum - 1) >> shift) + 1) : 1;
+        acc->exp = exp;
+    }
+    else {
+        shift = acc->exp - exp;
+        m = (shift < 64) ? (((m - 1) >> shift) + 1) : 1;
+    }
+
+    // The sum stays below 2^63, and m is at most 2^63, so this cannot overflow.
+    acc->sum += m;
+    while (acc->sum >= (UINT64_C(1) << 63)) {
+        acc->sum = ((acc->sum - 1) >> 1) + 1;
+        acc->exp++;
+    }
+}
+
+void arpra_helper_sumabs_get (mpfr_ptr y, const arpra_sumabs *acc)
+{
+    if (acc->nan) {
+        mpfr_set_nan(y);
+    }
+    else if (acc->inf) {
+        mpfr_set_inf(y, 1);
+    }
+    else {
+        mpfr_set_uj_2exp(y, acc->sum, acc->exp, MPFR_RNDU);
+    }
+}
+
+void arpra_helper_block_sumabs (mpfr_ptr y, mpfr_srcptr x, arpra_uint n)
+{
+    arpra_sumabs acc;
+    arpra_uint i;
+
+    arpra_helper_sumabs_init(&acc);
+    for (i = 0; i < n; i++) {
+        arpra_helper_sumabs_add(&acc, &(x[i]));
+    }
+    arpra_helper_sumabs_get(y, &acc);
+}
@@ -22,8 +22,8 @@
 #include "arpra-impl.h"
 
 // MPFR pointer buffer.
-static mpfr_ptr *buffer_mpfr_ptr = NULL;
-static arpra_uint buffer_mpfr_ptr_size = 0;
+static ARPRA_THREAD_LOCAL mpfr_ptr *buffer_mpfr_ptr = NULL;
+static ARPRA_THREAD_LOCAL arpra_uint buffer_mpfr_ptr_size = 0;
 
 mpfr_ptr *arpra_helper_buffer_mpfr_ptr (arpra_uint n)
 {
@@ -38,8 +38,8 @@ mpfr_ptr *arpra_helper_buffer_mpfr_ptr (arpra_uint n)
 }
 
 // MPFR buffer.
-static mpfr_ptr buffer_mpfr = NULL;
-static arpra_uint buffer_mpfr_size = 0;
+static ARPRA_THREAD_LOCAL mpfr_ptr buffer_mpfr = NULL;
+static ARPRA_THREAD_LOCAL arpra_uint buffer_mpfr_size = 0;
 
 mpfr_ptr arpra_helper_buffer_mpfr (arpra_uint n)
 {
@@ -53,7 +53,22 @@ mpfr_ptr arpra_helper_buffer_mpfr (arpra_uint n)
     return buffer_mpfr;
 }
 
-void arpra_clear_buffers ()
+// Arpra range buffer.
+static ARPRA_THREAD_LOCAL arpra_range buffer_range;
+static ARPRA_THREAD_LOCAL int buffer_range_init = 0;
+
+arpra_range *arpra_helper_buffer_range ()
+{
+    // Initialise, as required.
+    if (!buffer_range_init) {
+        arpra_init(&buffer_range);
+        buffer_range_init = 1;
+    }
+
+    return &buffer_range;
+}
+
+void arpra_helper_clear_buffers ()
 {
     // Free MPFR pointer buffer.
     free(buffer_mpfr_ptr);
@@ -64,4 +79,19 @@ void arpra_clear_buffers ()
     free(buffer_mpfr);
     buffer_mpfr = NULL;
     buffer_mpfr_size = 0;
+
+    // Clear Arpra range buffer.
+    if (buffer_range_init) {
+        arpra_clear(&buffer_range);
+        buffer_range_init = 0;
+    }
+
+    // Free pooled term blocks.
+    arpra_helper_clear_term_pool();
+}
+
+void arpra_clear_buffers ()
+{
+    arpra_helper_clear_pool();
+    arpra_helper_clear_buffers();
 }
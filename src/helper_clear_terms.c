@@ -26,11 +26,15 @@ void arpra_helper_clear_terms (arpra_range *y)
     arpra_uint i_y;
 
     if (y->nTerms > 0) {
-        for (i_y = 0; i_y < y->nTerms; i_y++) {
-            mpfr_clear(&(y->deviations[i_y]));
+        // Shared terms are freed by the last range to drop them.
+        if ((y->refs == NULL) || (__atomic_sub_fetch(y->refs, 1, __ATOMIC_ACQ_REL) == 0)) {
+            for (i_y = 0; i_y < y->nTerms; i_y++) {
+                mpfr_clear(&(y->deviations[i_y]));
+            }
+            arpra_helper_free_terms(y);
+            free(y->refs);
         }
-        free(y->symbols);
-        free(y->deviations);
         y->nTerms = 0;
     }
+    y->refs = NULL;
 }
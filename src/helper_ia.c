@@ -0,0 +1,50 @@
+/*
+ * helper_ia.c -- Interval arithmetic range functions.
+ *
+ * Copyright 2016-2020 James Paul Turner.
+ *
+ * This file is part of the Arpra library.
+ *
+ * The Arpra library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Arpra library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with the Arpra library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "arpra-impl.h"
+
+/*
+ * With the ARPRA_IA method, only the MPFI range of the result is computed.
+ * The result gets a single fresh deviation term spanning that range, so
+ * that it remains a sound operand for ranges using affine methods.
+ */
+
+void arpra_helper_ia_1 (arpra_range *y, int (*fn) (mpfi_ptr y, mpfi_srcptr x1),
+                        const arpra_range *x1)
+{
+    mpfi_t ia_range;
+
+    mpfi_init2(ia_range, y->precision);
+    fn(ia_range, &(x1->true_range));
+    arpra_helper_set_mpfi(y, ia_range, ARPRA_SYMBOL_APPROXIMATION);
+    mpfi_clear(ia_range);
+}
+
+void arpra_helper_ia_2 (arpra_range *y, int (*fn) (mpfi_ptr y, mpfi_srcptr x1, mpfi_srcptr x2),
+                        const arpra_range *x1, const arpra_range *x2)
+{
+    mpfi_t ia_range;
+
+    mpfi_init2(ia_range, y->precision);
+    fn(ia_range, &(x1->true_range), &(x2->true_range));
+    arpra_helper_set_mpfi(y, ia_range, ARPRA_SYMBOL_APPROXIMATION);
+    mpfi_clear(ia_range);
+}
@@ -21,24 +21,37 @@
 
 #include "arpra-impl.h"
 
-void arpra_helper_mix_trim (arpra_range *y, mpfi_srcptr ia_range)
+static void mix_trim (arpra_range *y, mpfi_srcptr ia_range, int collapse)
 {
     mpfr_t temp1, temp2;
     arpra_uint prec_internal;
+    arpra_range_method range_method;
+
+    range_method = arpra_helper_range_method(y);
 
     // Mixed IA/AA method.
-    if (arpra_get_range_method() == ARPRA_MIXED_IAAA) {
+    if (range_method == ARPRA_MIXED_IAAA) {
         // Intersect AA and IA ranges.
         mpfi_intersect(&(y->true_range), &(y->true_range), ia_range);
         //assert(!mpfi_is_empty(&(y->true_range)));
+
+        // Collapse to an interval if the affine form has stopped paying off.
+        if (collapse && arpra_helper_adaptive_collapse(y)) {
+            return;
+        }
     }
 
     // Mixed trimmed IA/AA method.
-    else if (arpra_get_range_method() == ARPRA_MIXED_TRIMMED_IAAA) {
+    else if (range_method == ARPRA_MIXED_TRIMMED_IAAA) {
         // Intersect AA and IA ranges.
         mpfi_intersect(&(y->true_range), &(y->true_range), ia_range);
         //assert(!mpfi_is_empty(&(y->true_range)));
 
+        // Collapse to an interval if the affine form has stopped paying off.
+        if (collapse && arpra_helper_adaptive_collapse(y)) {
+            return;
+        }
+
         // Initialise vars.
         prec_internal = arpra_get_internal_precision();
         mpfr_init2(temp1, prec_internal * 2);
@@ -53,6 +66,7 @@ void arpra_helper_mix_trim (arpra_range *y, mpfi_srcptr ia_range)
             mpfr_sub(temp2, temp2, &(y->true_range.right), MPFR_RNDD);
             mpfr_min(temp1, temp1, temp2, MPFR_RNDD);
 
+            arpra_helper_own_terms(y);
             mpfr_sub(&(y->deviations[y->nTerms - 1]), &(y->deviations[y->nTerms - 1]), temp1, MPFR_RNDU);
             if (mpfr_sgn(&(y->deviations[y->nTerms - 1])) < 0) {
                 mpfr_set_zero(&(y->deviations[y->nTerms - 1]), 1);
@@ -67,3 +81,18 @@ void arpra_helper_mix_trim (arpra_range *y, mpfi_srcptr ia_range)
         mpfr_clear(temp2);
     }
 }
+
+void arpra_helper_mix_trim (arpra_range *y, mpfi_srcptr ia_range)
+{
+    mix_trim(y, ia_range, 1);
+}
+
+/*
+ * As arpra_helper_mix_trim, but never collapse y, so that y keeps its noise
+ * symbols, and no new symbol is taken.
+ */
+
+void arpra_helper_mix_trim_keep_terms (arpra_range *y, mpfi_srcptr ia_range)
+{
+    mix_trim(y, ia_range, 0);
+}
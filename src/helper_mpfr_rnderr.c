@@ -68,6 +68,88 @@ void arpra_helper_mpfr_rnderr (mpfr_ptr err, mpfr_rnd_t rnd, mpfr_srcptr y)
     mpfr_clear(temp);
 }
 
+/*
+ * The arpra_rnderr accumulator does the same job as arpra_helper_mpfr_rnderr
+ * without any MPFR arithmetic per rounding error. Every rounding error is a
+ * power of two, so the accumulator counts them in units of 2^exp, where exp
+ * trails the largest error seen by ARPRA_RNDERR_WINDOW bits. Smaller errors
+ * count as one unit, and units are rescaled upward as larger errors arrive,
+ * so the count only ever overestimates the true sum.
+ */
+
+void arpra_helper_rnderr_init (arpra_rnderr *acc)
+{
+    acc->exp = 0;
+    acc->count = 0;
+}
+
+void arpra_helper_rnderr_add (arpra_rnderr *acc, mpfr_rnd_t rnd, mpfr_srcptr y)
+{
+    mpfr_exp_t e, shift;
+    unsigned long lost;
+
+    // Rounding error is 2^e.
+    if (mpfr_zero_p(y)) {
+        // y was flushed to zero, so rounding error is nextabove(0).
+        e = mpfr_get_emin() - 1;
+    }
+    else {
+        e = mpfr_get_exp(y) - mpfr_get_prec(y);
+        if ((rnd == MPFR_RNDN) || (rnd == MPFR_RNDNA)) {
+            e--;
+        }
+    }
+
+    // Start counting in units of 2^(e - window).
+    if (acc->count == 0) {
+        acc->exp = e - ARPRA_RNDERR_WINDOW;
+        acc->count = 1UL << ARPRA_RNDERR_WINDOW;
+        return;
+    }
+
+    // Rescale to larger units if 2^e is more than 2^window units.
+    if (e > (acc->exp + ARPRA_RNDERR_WINDOW)) {
+        shift = e - ARPRA_RNDERR_WINDOW - acc->exp;
+        if (shift >= (mpfr_exp_t) (sizeof(unsigned long) * CHAR_BIT)) {
+            acc->count = 1;
+        }
+        else {
+            lost = acc->count & ((1UL << shift) - 1);
+            acc->count = (acc->count >> shift) + (lost != 0);
+        }
+        acc->exp += shift;
+    }
+
+    // Add 2^e, rounding it up to at least one unit.
+    if (e > acc->exp) {
+        acc->count += 1UL << (e - acc->exp);
+    }
+    else {
+        acc->count += 1;
+    }
+
+    // Keep headroom for the next error.
+    if (acc->count > (ULONG_MAX >> 1)) {
+        acc->count = (acc->count >> 1) + (acc->count & 1);
+        acc->exp++;
+    }
+}
+
+void arpra_helper_rnderr_get (mpfr_ptr err, const arpra_rnderr *acc)
+{
+    mpfr_t temp;
+
+    if (acc->count == 0) {
+        return;
+    }
+
+    // Add count * 2^exp to err.
+    mpfr_init2(temp, sizeof(unsigned long) * CHAR_BIT);
+    mpfr_set_ui_2exp(temp, acc->count, acc->exp, MPFR_RNDU);
+    mpfr_add(err, err, temp, MPFR_RNDU);
+    mpfr_clear(temp);
+}
+
 
 
 
@@ -78,6 +160,12 @@ void arpra_helper_term_mul (mpfr_ptr error, mpfr_ptr y, mpfr_srcptr x1,
     mpfi_t y_range;
     arpra_prec prec_internal;
 
+    // Point coefficient: round y directly, and bound the error with the ternary value.
+    if (mpfr_equal_p(&(alpha->left), &(alpha->right))) {
+        ARPRA_MPFR_RNDERR_MUL(error, MPFR_RNDN, y, x1, &(alpha->left));
+        return;
+    }
+
     // Initialise vars.
     prec_internal = arpra_get_internal_precision();
     mpfr_init2(temp1, prec_internal);
@@ -112,6 +200,13 @@ void arpra_helper_term_fma (mpfr_ptr error, mpfr_ptr y, mpfr_srcptr x1,
     mpfi_t y_range, alpha_x1;
     arpra_prec prec_internal;
 
+    // Point coefficients: round y directly, and bound the error with the ternary value.
+    if (mpfr_equal_p(&(alpha->left), &(alpha->right))
+        && mpfr_equal_p(&(gamma->left), &(gamma->right))) {
+        ARPRA_MPFR_RNDERR_FMA(error, MPFR_RNDN, y, x1, &(alpha->left), &(gamma->left));
+        return;
+    }
+
     // a * b needs precision prec(a) + prec(b) to be exact.
 
     // Initialise vars.
@@ -151,6 +246,13 @@ void arpra_helper_term_fmma (mpfr_ptr error, mpfr_ptr y, mpfr_srcptr x1, mpfr_sr
     mpfi_t y_range, alpha_x1, beta_x2;
     arpra_prec prec_internal;
 
+    // Point coefficients: round y directly, and bound the error with the ternary value.
+    if (mpfr_equal_p(&(alpha->left), &(alpha->right))
+        && mpfr_equal_p(&(beta->left), &(beta->right))) {
+        ARPRA_MPFR_RNDERR_FMMA(error, MPFR_RNDN, y, x1, &(alpha->left), x2, &(beta->left));
+        return;
+    }
+
     // a * b needs precision prec(a) + prec(b) to be exact.
 
     // Initialise vars.
@@ -193,6 +295,14 @@ void arpra_helper_term_fmmaa (mpfr_ptr error, mpfr_ptr y, mpfr_srcptr x1, mpfr_s
     mpfi_t y_range, alpha_x1, beta_x2;
     arpra_prec prec_internal;
 
+    // Point coefficients: round y directly, and bound the error with the ternary value.
+    if (mpfr_equal_p(&(alpha->left), &(alpha->right))
+        && mpfr_equal_p(&(beta->left), &(beta->right))
+        && mpfr_equal_p(&(gamma->left), &(gamma->right))) {
+        ARPRA_MPFR_RNDERR_FMMAA(error, MPFR_RNDN, y, x1, &(alpha->left), x2, &(beta->left), &(gamma->left));
+        return;
+    }
+
     // a * b needs precision prec(a) + prec(b) to be exact.
 
     // Initialise vars.
@@ -0,0 +1,156 @@
+/*
+ * helper_ode_f.c -- Evaluate the right-hand side of an ODE system.
+ *
+ * Copyright 2018-2020 James Paul Turner.
+ *
+ * This file is part of the Arpra library.
+ *
+ * The Arpra library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Arpra library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with the Arpra library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "arpra-impl.h"
+
+typedef struct ode_f_job_struct
+{
+    arpra_ode_system *system;
+    arpra_range **dxdt;
+    const arpra_range *t;
+    const arpra_range **x;
+    arpra_uint *grp;
+    arpra_uint *dim;
+} ode_f_job;
+
+// Params of group x_grp for the thread running its callback.
+static void *ode_f_params (arpra_ode_system *system, arpra_uint x_grp)
+{
+    if (system->worker_params != NULL) {
+        return system->worker_params[arpra_helper_get_worker()][x_grp];
+    }
+    return system->params[x_grp];
+}
+
+static void ode_f_group (arpra_ode_system *system, arpra_range **dxdt,
+                         const arpra_range *t, const arpra_range **x, arpra_uint x_grp)
+{
+    arpra_uint x_dim;
+    void *params;
+
+    params = ode_f_params(system, x_grp);
+    if ((system->f_grp != NULL) && (system->f_grp[x_grp] != NULL)) {
+        system->f_grp[x_grp](dxdt, params, t, x, x_grp);
+    }
+    else if ((system->f != NULL) && (system->f[x_grp] != NULL)) {
+        for (x_dim = 0; x_dim < system->dims[x_grp]; x_dim++) {
+            system->f[x_grp](&(dxdt[x_grp][x_dim]), params, t, x, x_grp, x_dim);
+        }
+    }
+}
+
+static void ode_f_task (void *arg, arpra_uint i)
+{
+    arpra_uint x_grp, x_dim;
+    arpra_ode_system *system;
+    ode_f_job *job;
+    void *params;
+
+    job = (ode_f_job *) arg;
+    system = job->system;
+    x_grp = job->grp[i];
+    x_dim = job->dim[i];
+    params = ode_f_params(system, x_grp);
+
+    // Tasks are either a whole group, or one dimension of a group.
+    if ((system->f_grp != NULL) && (system->f_grp[x_grp] != NULL)) {
+        system->f_grp[x_grp](job->dxdt, params, job->t, job->x, x_grp);
+    }
+    else {
+        system->f[x_grp](&(job->dxdt[x_grp][x_dim]), params, job->t, job->x, x_grp, x_dim);
+    }
+}
+
+static void ode_f_parallel (arpra_ode_system *system, arpra_range **dxdt,
+                            const arpra_range *t, const arpra_range **x)
+{
+    arpra_uint x_grp, x_dim, n, workers;
+    ode_f_job job;
+
+    // List tasks in serial order.
+    for (x_grp = 0, n = 0; x_grp < system->grps; x_grp++) {
+        n += system->dims[x_grp];
+    }
+    job.system = system;
+    job.dxdt = dxdt;
+    job.t = t;
+    job.x = x;
+    job.grp = malloc(n * sizeof(arpra_uint));
+    job.dim = malloc(n * sizeof(arpra_uint));
+    for (x_grp = 0, n = 0; x_grp < system->grps; x_grp++) {
+        if ((system->f_grp != NULL) && (system->f_grp[x_grp] != NULL)) {
+            job.grp[n] = x_grp;
+            job.dim[n] = 0;
+            n++;
+        }
+        else if ((system->f != NULL) && (system->f[x_grp] != NULL)) {
+            for (x_dim = 0; x_dim < system->dims[x_grp]; x_dim++) {
+                job.grp[n] = x_grp;
+                job.dim[n] = x_dim;
+                n++;
+            }
+        }
+    }
+
+    // Use one thread per params array, if there are per-thread params.
+    workers = 0;
+    if (system->worker_params != NULL) {
+        workers = (system->workers > 0) ? system->workers : 1;
+    }
+
+    arpra_helper_parallel_for(&ode_f_task, &job, n, workers, dxdt, system->grps, system->dims);
+
+    free(job.grp);
+    free(job.dim);
+}
+
+void arpra_helper_ode_f (arpra_ode_stepper *stepper, arpra_range **dxdt,
+                         const arpra_range *t, const arpra_range **x)
+{
+    arpra_uint x_grp, x_dim;
+    arpra_ode_system *system;
+
+    system = stepper->system;
+
+    // Compute dirty ranges before any callback reads t and x, so that every
+    // callback sees the same ranges, and tasks never update shared ranges.
+    arpra_helper_update_range(t);
+    for (x_grp = 0; x_grp < system->grps; x_grp++) {
+        for (x_dim = 0; x_dim < system->dims[x_grp]; x_dim++) {
+            arpra_helper_update_range(&(x[x_grp][x_dim]));
+        }
+    }
+
+    // dxdt = f(t, x)
+    if (arpra_get_threads() <= 1) {
+        for (x_grp = 0; x_grp < system->grps; x_grp++) {
+            ode_f_group(system, dxdt, t, x, x_grp);
+        }
+    }
+    else {
+        ode_f_parallel(system, dxdt, t, x);
+    }
+
+    // Reduce stage deviation terms.
+    if ((stepper->reduce != NULL) && stepper->reduce->per_stage) {
+        arpra_helper_ode_reduce(stepper, dxdt, 1);
+    }
+}
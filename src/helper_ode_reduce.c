@@ -0,0 +1,113 @@
+/*
+ * helper_ode_reduce.c -- Apply an ODE stepper's term reduction policy.
+ *
+ * Copyright 2018-2020 James Paul Turner.
+ *
+ * This file is part of the Arpra library.
+ *
+ * The Arpra library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Arpra library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with the Arpra library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "arpra-impl.h"
+
+typedef struct ode_reduce_job_struct
+{
+    arpra_ode_stepper *stepper;
+    arpra_range **x;
+    int stage;
+    arpra_uint *grp;
+    arpra_uint *dim;
+} ode_reduce_job;
+
+static void ode_reduce_element (arpra_ode_stepper *stepper, arpra_range *x, int stage)
+{
+    const arpra_ode_reduce *reduce;
+    arpra_uint n;
+
+    reduce = stepper->reduce;
+    arpra_helper_set_reduce_classes_local(reduce->classes);
+
+    // Condense terms created during this step.
+    if (reduce->new_terms) {
+        n = 0;
+        while ((n < x->nTerms) && (x->symbols[x->nTerms - n - 1] >= stepper->reduce_epoch)) {
+            n++;
+        }
+        if (n > 1) {
+            arpra_reduce_last_n(x, x, n);
+        }
+    }
+
+    // Condense smallest terms down to max_terms.
+    if ((reduce->max_terms > 0) && (x->nTerms > reduce->max_terms)) {
+        arpra_reduce_keep_k(x, x, (reduce->max_terms - 1));
+    }
+
+    // Condense small terms every rel_steps steps.
+    if (!stage && (reduce->rel_threshold != NULL)) {
+        if ((reduce->rel_steps <= 1) || (stepper->steps % reduce->rel_steps == 0)) {
+            arpra_reduce_small_rel(x, x, reduce->rel_threshold);
+        }
+    }
+
+    arpra_helper_set_reduce_classes_local(0);
+}
+
+static void ode_reduce_task (void *arg, arpra_uint i)
+{
+    ode_reduce_job *job;
+
+    job = (ode_reduce_job *) arg;
+    ode_reduce_element(job->stepper, &(job->x[job->grp[i]][job->dim[i]]), job->stage);
+}
+
+void arpra_helper_ode_reduce (arpra_ode_stepper *stepper, arpra_range **x, int stage)
+{
+    arpra_uint x_grp, x_dim, i;
+    arpra_ode_system *system;
+    ode_reduce_job job;
+
+    system = stepper->system;
+
+    if (arpra_get_threads() <= 1) {
+        for (x_grp = 0; x_grp < system->grps; x_grp++) {
+            for (x_dim = 0; x_dim < system->dims[x_grp]; x_dim++) {
+                ode_reduce_element(stepper, &(x[x_grp][x_dim]), stage);
+            }
+        }
+        return;
+    }
+
+    // List tasks in serial order.
+    for (x_grp = 0, i = 0; x_grp < system->grps; x_grp++) {
+        i += system->dims[x_grp];
+    }
+    job.stepper = stepper;
+    job.x = x;
+    job.stage = stage;
+    job.grp = malloc(i * sizeof(arpra_uint));
+    job.dim = malloc(i * sizeof(arpra_uint));
+    for (x_grp = 0, i = 0; x_grp < system->grps; x_grp++) {
+        for (x_dim = 0; x_dim < system->dims[x_grp]; x_dim++) {
+            job.grp[i] = x_grp;
+            job.dim[i] = x_dim;
+            i++;
+        }
+    }
+
+    arpra_helper_parallel_for(&ode_reduce_task, &job, i, 0, x, system->grps, system->dims);
+
+    free(job.grp);
+    free(job.dim);
+}
@@ -0,0 +1,112 @@
+/*
+ * helper_ode_sum.c -- Combine ODE stages into a new state.
+ *
+ * Copyright 2018-2020 James Paul Turner.
+ *
+ * This file is part of the Arpra library.
+ *
+ * The Arpra library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Arpra library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with the Arpra library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "arpra-impl.h"
+
+typedef struct ode_sum_job_struct
+{
+    arpra_range **y;
+    arpra_range **x;
+    const arpra_range *a;
+    arpra_range ***k;
+    arpra_uint n;
+    arpra_uint *grp;
+    arpra_uint *dim;
+} ode_sum_job;
+
+static void ode_sum_element (arpra_range *y, arpra_range *x, const arpra_range *a,
+                             arpra_range ***k, arpra_uint n, arpra_uint x_grp, arpra_uint x_dim)
+{
+    arpra_uint k_j;
+    arpra_range *temp_x;
+
+    temp_x = arpra_helper_buffer_range();
+    arpra_set_precision(temp_x, arpra_get_precision(y));
+    for (k_j = 0; k_j < n; k_j++) {
+        arpra_mul(temp_x, &(a[k_j]), &(k[k_j][x_grp][x_dim]));
+        arpra_add(y, ((k_j == 0) ? x : y), temp_x);
+    }
+}
+
+static void ode_sum_task (void *arg, arpra_uint i)
+{
+    arpra_uint x_grp, x_dim;
+    ode_sum_job *job;
+
+    job = (ode_sum_job *) arg;
+    x_grp = job->grp[i];
+    x_dim = job->dim[i];
+
+    ode_sum_element(&(job->y[x_grp][x_dim]), &(job->x[x_grp][x_dim]),
+                    job->a, job->k, job->n, x_grp, x_dim);
+}
+
+void arpra_helper_ode_sum (arpra_ode_stepper *stepper, arpra_range **y, arpra_range **x,
+                           const arpra_range *a, arpra_range ***k, arpra_uint n)
+{
+    arpra_uint x_grp, x_dim, i;
+    arpra_ode_system *system;
+    ode_sum_job job;
+
+    system = stepper->system;
+    if (n == 0) {
+        return;
+    }
+
+    // Compute dirty ranges of the coefficients, which every element reads.
+    for (i = 0; i < n; i++) {
+        arpra_helper_update_range(&(a[i]));
+    }
+
+    // y = x + a[0] k[0] + ... + a[n - 1] k[n - 1]
+    if (arpra_get_threads() <= 1) {
+        for (x_grp = 0; x_grp < system->grps; x_grp++) {
+            for (x_dim = 0; x_dim < system->dims[x_grp]; x_dim++) {
+                ode_sum_element(&(y[x_grp][x_dim]), &(x[x_grp][x_dim]), a, k, n, x_grp, x_dim);
+            }
+        }
+        return;
+    }
+
+    // List tasks in serial order.
+    for (x_grp = 0, i = 0; x_grp < system->grps; x_grp++) {
+        i += system->dims[x_grp];
+    }
+    job.y = y;
+    job.x = x;
+    job.a = a;
+    job.k = k;
+    job.n = n;
+    job.grp = malloc(i * sizeof(arpra_uint));
+    job.dim = malloc(i * sizeof(arpra_uint));
+    for (x_grp = 0, i = 0; x_grp < system->grps; x_grp++) {
+        for (x_dim = 0; x_dim < system->dims[x_grp]; x_dim++) {
+            job.grp[i] = x_grp;
+            job.dim[i] = x_dim;
+            i++;
+        }
+    }
+
+    arpra_helper_parallel_for(&ode_sum_task, &job, i, 0, y, system->grps, system->dims);
+
+    free(job.grp);
+    free(job.dim);
+}
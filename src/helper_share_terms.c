@@ -0,0 +1,93 @@
+/*
+ * helper_share_terms.c -- Share deviation terms between ranges.
+ *
+ * Copyright 2016-2020 James Paul Turner.
+ *
+ * This file is part of the Arpra library.
+ *
+ * The Arpra library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Arpra library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with the Arpra library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "arpra-impl.h"
+
+/*
+ * Deviation terms are immutable once an operation has built them, so ranges
+ * holding identical terms can share one copy. Shared terms are reference
+ * counted through the refs field, which stays NULL until the terms are first
+ * shared. Functions that modify terms in place must call
+ * arpra_helper_own_terms first.
+ */
+
+void arpra_helper_share_terms (arpra_range *y, const arpra_range *x1)
+{
+    arpra_range *x;
+    arpra_uint *refs, *expected;
+
+    arpra_helper_clear_terms(y);
+    if (x1->nTerms == 0) {
+        return;
+    }
+
+    // The first share attaches a reference count to x1's terms.
+    x = (arpra_range *) x1;
+    refs = __atomic_load_n(&(x->refs), __ATOMIC_ACQUIRE);
+    if (refs == NULL) {
+        refs = malloc(sizeof(arpra_uint));
+        *refs = 1;
+        expected = NULL;
+        if (!__atomic_compare_exchange_n(&(x->refs), &expected, refs, 0,
+                                         __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+            free(refs);
+            refs = expected;
+        }
+    }
+    __atomic_add_fetch(refs, 1, __ATOMIC_RELAXED);
+
+    y->symbols = x1->symbols;
+    y->deviations = x1->deviations;
+    y->nTerms = x1->nTerms;
+    y->wide_ops = x1->wide_ops;
+    y->refs = refs;
+}
+
+void arpra_helper_own_terms (arpra_range *y)
+{
+    arpra_range yy;
+    arpra_uint i_y;
+
+    if (y->refs == NULL) {
+        return;
+    }
+
+    // Nobody else holds these terms.
+    if (__atomic_load_n(y->refs, __ATOMIC_ACQUIRE) == 1) {
+        free(y->refs);
+        y->refs = NULL;
+        return;
+    }
+
+    // Copy the terms, and drop the shared reference.
+    arpra_helper_alloc_terms(&yy, y->nTerms);
+    for (i_y = 0; i_y < y->nTerms; i_y++) {
+        yy.symbols[i_y] = y->symbols[i_y];
+        mpfr_init2(&(yy.deviations[i_y]), mpfr_get_prec(&(y->deviations[i_y])));
+        mpfr_set(&(yy.deviations[i_y]), &(y->deviations[i_y]), MPFR_RNDN);
+    }
+    yy.nTerms = y->nTerms;
+    arpra_helper_clear_terms(y);
+    y->symbols = yy.symbols;
+    y->deviations = yy.deviations;
+    y->nTerms = yy.nTerms;
+}
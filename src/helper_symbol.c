@@ -22,10 +22,26 @@
 #include "arpra-impl.h"
 
 static arpra_uint symbol_count = 0;
+static ARPRA_THREAD_LOCAL arpra_uint *symbol_local = NULL;
+static ARPRA_THREAD_LOCAL arpra_uint symbol_local_end = 0;
 
-arpra_uint arpra_helper_next_symbol ()
+arpra_symbol arpra_helper_next_symbol (arpra_symbol_class class)
 {
-    return symbol_count++;
+    arpra_uint *counter;
+    arpra_symbol symbol;
+
+    counter = (symbol_local != NULL) ? symbol_local : &symbol_count;
+    if (*counter > (ARPRA_SYMBOL_MAX - ARPRA_SYMBOL_CLASS_MASK)) {
+        fprintf(stderr, "Arpra: out of noise symbols (see arpra_renumber_symbols).\n");
+        abort();
+    }
+    if ((symbol_local != NULL) && (*counter >= symbol_local_end)) {
+        fprintf(stderr, "Arpra: out of noise symbols in a parallel task.\n");
+        abort();
+    }
+    symbol = *counter | class;
+    *counter += ARPRA_SYMBOL_CLASS_MASK + 1;
+    return symbol;
 }
 
 arpra_uint arpra_helper_get_symbol_count ()
@@ -37,3 +53,14 @@ void arpra_helper_set_symbol_count (arpra_uint n)
 {
     symbol_count = n;
 }
+
+/*
+ * Take symbols from counter instead of the global count in this thread,
+ * until it reaches end, or from the global count again if counter is NULL.
+ */
+
+void arpra_helper_set_symbol_local (arpra_uint *counter, arpra_uint end)
+{
+    symbol_local = counter;
+    symbol_local_end = end;
+}
@@ -51,17 +51,26 @@ void arpra_increase (arpra_range *y, const arpra_range *x1, mpfr_srcptr delta)
     mpfi_set(ia_range, &(x1->true_range));
     mpfi_increase(ia_range, delta);
 
+    // Interval method.
+    if (arpra_helper_range_method(y) == ARPRA_IA) {
+        arpra_helper_set_mpfi(y, ia_range, arpra_get_symbol_class());
+        mpfi_clear(ia_range);
+        mpfi_clear(alpha);
+        mpfi_clear(gamma);
+        return;
+    }
+
     // y = increase(x1, delta)
     arpra_helper_affine_1(y, x1, alpha, gamma, delta);
 
-    // Compute true_range.
-    arpra_helper_compute_range(y);
-
-    // Mix with IA range, and trim error term.
-    arpra_helper_mix_trim(y, ia_range);
+    // The new symbol carries delta, so it takes the class of input symbols.
+    if (!mpfr_zero_p(delta)) {
+        y->symbols[y->nTerms - 1] &= ~ARPRA_SYMBOL_CLASS_MASK;
+        y->symbols[y->nTerms - 1] |= arpra_get_symbol_class();
+    }
 
-    // Check for NaN and Inf.
-    arpra_helper_check_result(y);
+    // Compute true_range, or defer it until it is needed.
+    arpra_helper_defer_range(y, ia_range);
 
     // Clear vars.
     mpfi_clear(ia_range);
@@ -31,12 +31,24 @@ void arpra_init (arpra_range *y)
 
 void arpra_init2 (arpra_range *y, arpra_prec prec)
 {
-    arpra_prec prec_internal;
+    arpra_init3(y, prec, 0);
+}
 
+void arpra_init3 (arpra_range *y, arpra_prec prec, arpra_prec prec_internal)
+{
+    // An internal precision of 0 follows the global internal precision.
     y->precision = prec;
-    prec_internal = arpra_get_internal_precision();
+    y->deviation_precision = arpra_get_default_deviation_precision();
+    y->internal_precision = prec_internal;
+    y->range_method = ARPRA_GLOBAL_RANGE_METHOD;
+    if (prec_internal == 0) {
+        prec_internal = arpra_get_internal_precision();
+    }
     mpfr_init2(&(y->centre), prec_internal);
     mpfr_init2(&(y->radius), prec_internal);
     mpfi_init2(&(y->true_range), prec);
     y->nTerms = 0;
+    y->wide_ops = 0;
+    y->dirty = ARPRA_RANGE_CLEAN;
+    y->refs = NULL;
 }
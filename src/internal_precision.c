@@ -21,10 +21,33 @@
 
 #include "arpra-impl.h"
 
+/*
+ * Ranges initialised with arpra_init3 have their own internal precision,
+ * and operations work at the largest internal precision of their operands,
+ * or the global internal precision for operands without one.
+ *
+ * With adaptive precision enabled, each operation instead works at just
+ * enough precision for its operands, up to their internal precision.
+ * Rounding error is at most 2^-p relative to each rounded number, so p
+ * needs to be a guard above both the target precision of y and the
+ * exponent gap between the centre and radius of each operand. The chosen
+ * precision is rounded up to whole limbs. Point operands add no gap, so
+ * operations on points alone keep the internal precision.
+ *
+ * The working precision is returned by arpra_get_internal_precision until
+ * the operation ends.
+ */
+
 static arpra_prec internal_precision = ARPRA_DEFAULT_INTERNAL_PRECISION;
+static int adaptive_precision = 0;
+static arpra_uint adaptive_precision_counts[ARPRA_ADAPTIVE_COUNTERS];
+static ARPRA_THREAD_LOCAL arpra_prec op_precision = 0;
 
 arpra_prec arpra_get_internal_precision ()
 {
+    if (op_precision != 0) {
+        return op_precision;
+    }
     return internal_precision;
 }
 
@@ -32,3 +55,106 @@ void arpra_set_internal_precision (arpra_prec prec)
 {
     internal_precision = prec;
 }
+
+int arpra_get_adaptive_precision ()
+{
+    return adaptive_precision;
+}
+
+void arpra_set_adaptive_precision (int enable)
+{
+    adaptive_precision = enable;
+}
+
+arpra_uint arpra_get_adaptive_precision_count (arpra_prec prec)
+{
+    arpra_uint i;
+
+    i = (prec - 1) / GMP_NUMB_BITS;
+    if (i >= ARPRA_ADAPTIVE_COUNTERS) {
+        i = ARPRA_ADAPTIVE_COUNTERS - 1;
+    }
+    return __atomic_load_n(&(adaptive_precision_counts[i]), __ATOMIC_RELAXED);
+}
+
+void arpra_reset_adaptive_precision_stats ()
+{
+    arpra_uint i;
+
+    for (i = 0; i < ARPRA_ADAPTIVE_COUNTERS; i++) {
+        __atomic_store_n(&(adaptive_precision_counts[i]), 0, __ATOMIC_RELAXED);
+    }
+}
+
+arpra_prec arpra_helper_range_precision (const arpra_range *x1)
+{
+    if (x1->internal_precision != 0) {
+        return x1->internal_precision;
+    }
+    return internal_precision;
+}
+
+arpra_prec arpra_helper_op_precision (arpra_prec prec, const arpra_range *y, const arpra_range *x1)
+{
+    mpfr_exp_t need;
+    arpra_prec prec_x1;
+
+    // Without adaptive precision, operations use the largest internal precision of their operands.
+    prec_x1 = arpra_helper_range_precision(x1);
+    if (!adaptive_precision) {
+        return (prec_x1 > prec) ? prec_x1 : prec;
+    }
+
+    // Point operands add nothing to the precision of the operation.
+    if (mpfr_zero_p(&(x1->radius))) {
+        return prec;
+    }
+
+    need = y->precision;
+    if (!mpfr_regular_p(&(x1->radius))) {
+        need = prec_x1;
+    }
+    else if (mpfr_regular_p(&(x1->centre))
+             && ((mpfr_get_exp(&(x1->centre)) - mpfr_get_exp(&(x1->radius))) > need)) {
+        need = mpfr_get_exp(&(x1->centre)) - mpfr_get_exp(&(x1->radius));
+    }
+    need += ARPRA_ADAPTIVE_GUARD;
+
+    // Round up to whole limbs, within the internal precision of x1.
+    if (need > prec_x1) {
+        need = prec_x1;
+    }
+    need = ((need + GMP_NUMB_BITS - 1) / GMP_NUMB_BITS) * GMP_NUMB_BITS;
+    if (need > prec_x1) {
+        need = prec_x1;
+    }
+    return (need > prec) ? need : prec;
+}
+
+arpra_prec arpra_helper_push_precision (arpra_prec prec)
+{
+    arpra_prec prev;
+    arpra_uint i;
+
+    // Zero leaves the precision unchanged.
+    prev = op_precision;
+    if (prec == 0) {
+        return prev;
+    }
+
+    if (adaptive_precision) {
+        i = (prec - 1) / GMP_NUMB_BITS;
+        if (i >= ARPRA_ADAPTIVE_COUNTERS) {
+            i = ARPRA_ADAPTIVE_COUNTERS - 1;
+        }
+        __atomic_add_fetch(&(adaptive_precision_counts[i]), 1, __ATOMIC_RELAXED);
+    }
+
+    op_precision = prec;
+    return prev;
+}
+
+void arpra_helper_pop_precision (arpra_prec prev)
+{
+    op_precision = prev;
+}
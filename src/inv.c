@@ -51,6 +51,15 @@ void arpra_inv (arpra_range *y, const arpra_range *x1)
         return;
     }
 
+    // Interval method.
+    if (arpra_helper_range_method(y) == ARPRA_IA) {
+        arpra_helper_ia_1(y, mpfi_inv, x1);
+        return;
+    }
+
+    // Compute the range of x1, if it is dirty.
+    arpra_helper_update_range(x1);
+
     // Handle zero-width x1.
     if (mpfr_equal_p(&(x1->true_range.left), &(x1->true_range.right))) {
         arpra_mpfr_ui_fn2(mpfr_ui_div, y, 1, &(x1->true_range.left));
@@ -0,0 +1,114 @@
+/*
+ * lazy_range.c -- Defer computing the range of affine results.
+ *
+ * Copyright 2016-2020 James Paul Turner.
+ *
+ * This file is part of the Arpra library.
+ *
+ * The Arpra library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Arpra library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with the Arpra library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "arpra-impl.h"
+
+/*
+ * The affine helpers sum the radius of their result as they generate its
+ * terms, but leave its true_range to arpra_helper_compute_range, and mark
+ * the result dirty until then. With lazy ranges enabled, affine operations
+ * stop there, and keep their MPFI range as the true_range of the result.
+ * That is a valid enclosure for the IA parts of later operations, and for
+ * NaN and Inf checks, so a chain of affine operations never computes and
+ * mixes its intermediate ranges.
+ *
+ * Anything else reading the true_range of a range, such as the arpra_get_
+ * functions, predicates, non-affine operations and reductions, first calls
+ * arpra_helper_update_range to compute it from the radius, and mix it with
+ * the saved MPFI range as an eager operation would have done.
+ *
+ * Updating a range writes its radius, true_range and last deviation term,
+ * so it must not run while another thread reads the range. Parallel ODE
+ * evaluation therefore updates the time, state and coefficient ranges that
+ * its tasks share before starting them, and ranges shared through the
+ * params of an ODE system must be clean before a step.
+ *
+ * An update never takes a new noise symbol, since a task may still update
+ * a range it did not create, where a new symbol would not be renumbered.
+ * Dirty ranges are therefore never collapsed, and keep the saved MPFI range
+ * if their affine range overflows. If two threads update the same range,
+ * the first to claim it does the work, and the other waits for it.
+ */
+
+static int lazy_range = 0;
+
+int arpra_get_lazy_range ()
+{
+    return lazy_range;
+}
+
+void arpra_set_lazy_range (int enable)
+{
+    lazy_range = enable;
+}
+
+void arpra_helper_defer_range (arpra_range *y, mpfi_srcptr ia_range)
+{
+    // Resolve unbounded ranges straight away.
+    if (!lazy_range || !mpfi_bounded_p(ia_range)) {
+        arpra_helper_compute_range(y);
+        arpra_helper_mix_trim(y, ia_range);
+        arpra_helper_check_result(y);
+        return;
+    }
+
+    // Keep the MPFI range until true_range is needed.
+    mpfi_set(&(y->true_range), ia_range);
+}
+
+void arpra_helper_update_range (const arpra_range *x1)
+{
+    arpra_range *x;
+    mpfi_t ia_range;
+    int expected;
+
+    if (__atomic_load_n(&(x1->dirty), __ATOMIC_ACQUIRE) == ARPRA_RANGE_CLEAN) {
+        return;
+    }
+
+    // Claim the range, or wait for the thread that claimed it.
+    x = (arpra_range *) x1;
+    expected = ARPRA_RANGE_DIRTY;
+    if (!__atomic_compare_exchange_n(&(x->dirty), &expected, ARPRA_RANGE_UPDATING, 0,
+                                     __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+        while (__atomic_load_n(&(x->dirty), __ATOMIC_ACQUIRE) != ARPRA_RANGE_CLEAN);
+        return;
+    }
+
+    // Initialise vars.
+    mpfi_init2(ia_range, x->precision);
+    mpfi_set(ia_range, &(x->true_range));
+
+    // Compute true_range.
+    arpra_helper_compute_range(x);
+
+    // Mix with IA range, and trim error term.
+    arpra_helper_mix_trim_keep_terms(x, ia_range);
+
+    // Fall back to the IA range if the affine range is NaN or Inf.
+    if (!mpfi_bounded_p(&(x->true_range))) {
+        mpfi_set(&(x->true_range), ia_range);
+    }
+
+    // Clear vars.
+    mpfi_clear(ia_range);
+    __atomic_store_n(&(x->dirty), ARPRA_RANGE_CLEAN, __ATOMIC_RELEASE);
+}
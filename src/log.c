@@ -46,6 +46,15 @@ void arpra_log (arpra_range *y, const arpra_range *x1)
         return;
     }
 
+    // Interval method.
+    if (arpra_helper_range_method(y) == ARPRA_IA) {
+        arpra_helper_ia_1(y, mpfi_log, x1);
+        return;
+    }
+
+    // Compute the range of x1, if it is dirty.
+    arpra_helper_update_range(x1);
+
     // Handle zero-width x1.
     if (mpfr_equal_p(&(x1->true_range.left), &(x1->true_range.right))) {
         arpra_mpfr_fn1(mpfr_log, y, &(x1->true_range.left));
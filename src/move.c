@@ -0,0 +1,46 @@
+/*
+ * move.c -- Move an Arpra range.
+ *
+ * Copyright 2016-2020 James Paul Turner.
+ *
+ * This file is part of the Arpra library.
+ *
+ * The Arpra library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Arpra library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with the Arpra library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "arpra-impl.h"
+
+void arpra_move (arpra_range *y, arpra_range *x1)
+{
+    arpra_range temp;
+    arpra_prec prec;
+
+    // Handle y = x1 case.
+    if (y == x1) return;
+
+    // y takes over x1, including its precision, and x1 is reinitialised.
+    // Per-range settings stay with each range.
+    prec = x1->precision;
+    temp = *y;
+    arpra_clear(y);
+    *y = *x1;
+    y->deviation_precision = temp.deviation_precision;
+    y->internal_precision = temp.internal_precision;
+    y->range_method = temp.range_method;
+    temp = *x1;
+    arpra_init3(x1, prec, temp.internal_precision);
+    x1->deviation_precision = temp.deviation_precision;
+    x1->range_method = temp.range_method;
+}
@@ -32,18 +32,21 @@
         prec_internal = arpra_get_internal_precision();                 \
         mpfr_init2(error, prec_internal);                               \
         arpra_init2(&yy, y->precision);                                 \
+        yy.deviation_precision = y->deviation_precision;                \
+        yy.internal_precision = y->internal_precision;                  \
+        yy.range_method = y->range_method;                              \
         mpfr_set_zero(error, 1);                                        \
                                                                         \
         /* y[0] = fn(x) */                                              \
         MPFR_CALL;                                                      \
                                                                         \
         /* Allocate memory for deviation terms. */                      \
-        yy.symbols = malloc(sizeof(arpra_uint));                        \
-        yy.deviations = malloc(sizeof(mpfr_t));                         \
+        arpra_helper_alloc_terms(&yy, 1);                               \
                                                                         \
         /* Store new deviation term. */                                 \
-        yy.symbols[0] = arpra_helper_next_symbol();                     \
+        yy.symbols[0] = arpra_helper_next_symbol(ARPRA_SYMBOL_ROUNDING); \
         yy.deviations[0] = *error;                                      \
+        mpfr_abs(&(yy.radius), error, MPFR_RNDU);                       \
         yy.nTerms = 1;                                                  \
                                                                         \
         /* Compute true_range. */                                       \
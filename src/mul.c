@@ -161,10 +161,12 @@ void arpra_mul (arpra_range *y, const arpra_range *x1, const arpra_range *x2)
 {
     mpfi_t ia_range;
     mpfr_t error;
+    arpra_rnderr rnderr;
+    arpra_sumabs radius;
     arpra_range yy;
     arpra_uint i_y, i_x1, i_x2;
-    arpra_int x1HasNext, x2HasNext;
-    arpra_prec prec_internal;
+    unsigned char step;
+    arpra_prec prec_internal, prec_deviation, prec_op, prec_prev;
 
     // Domain violations:
     // (NaN) * (NaN) = (NaN)
@@ -200,50 +202,70 @@ void arpra_mul (arpra_range *y, const arpra_range *x1, const arpra_range *x2)
         return;
     }
 
+    // Interval method.
+    if (arpra_helper_range_method(y) == ARPRA_IA) {
+        arpra_helper_ia_2(y, mpfi_mul, x1, x2);
+        return;
+    }
+
+    // Compute the ranges of x1 and x2, if they are dirty.
+    arpra_helper_update_range(x1);
+    arpra_helper_update_range(x2);
+
+    // Choose the working precision.
+    prec_op = arpra_helper_op_precision(0, y, x1);
+    prec_op = arpra_helper_op_precision(prec_op, y, x2);
+    prec_prev = arpra_helper_push_precision(prec_op);
+
     // Initialise vars.
     prec_internal = arpra_get_internal_precision();
+    prec_deviation = arpra_helper_deviation_precision(y);
     mpfi_init2(ia_range, y->precision);
     mpfr_init2(error, prec_internal);
     arpra_init2(&yy, y->precision);
+    yy.deviation_precision = y->deviation_precision;
+    yy.internal_precision = y->internal_precision;
+    yy.range_method = y->range_method;
+    yy.wide_ops = (x1->wide_ops > x2->wide_ops) ? x1->wide_ops : x2->wide_ops;
     mpfr_set_zero(error, 1);
+    arpra_helper_rnderr_init(&rnderr);
+    arpra_helper_sumabs_init(&radius);
 
     // y[0] = x1[0] * x2[0]
     ARPRA_MPFR_RNDERR_MUL(error, MPFR_RNDN, &(yy.centre), &(x1->centre), &(x2->centre));
 
     // Allocate memory for deviation terms.
-    yy.symbols = malloc((x1->nTerms + x2->nTerms + 1) * sizeof(arpra_uint));
-    yy.deviations = malloc((x1->nTerms + x2->nTerms + 1) * sizeof(mpfr_t));
-
-    i_y = 0;
-    i_x1 = 0;
-    i_x2 = 0;
-    x1HasNext = x1->nTerms > 0;
-    x2HasNext = x2->nTerms > 0;
-    while (x1HasNext || x2HasNext) {
-        mpfr_init2(&(yy.deviations[i_y]), prec_internal);
-
-        if ((!x2HasNext) || (x1HasNext && (x1->symbols[i_x1] < x2->symbols[i_x2]))) {
+    arpra_helper_alloc_terms(&yy, x1->nTerms + x2->nTerms + 1);
+
+    for (i_y = 0, i_x1 = 0, i_x2 = 0; (i_x1 < x1->nTerms) || (i_x2 < x2->nTerms); i_y++) {
+        mpfr_init2(&(yy.deviations[i_y]), prec_deviation);
+        step = ARPRA_MERGE_STEP(x1, i_x1, x2, i_x2);
+
+        if (step == ARPRA_MERGE_X1) {
             // y[i] = (x2[0] * x1[i])
             yy.symbols[i_y] = x1->symbols[i_x1];
-            ARPRA_MPFR_RNDERR_MUL(error, MPFR_RNDN, &(yy.deviations[i_y]), &(x2->centre), &(x1->deviations[i_x1]));
-            x1HasNext = ++i_x1 < x1->nTerms;
+            ARPRA_MPFR_RNDACC_MUL(&rnderr, MPFR_RNDN, &(yy.deviations[i_y]), &(x2->centre), &(x1->deviations[i_x1]));
+            i_x1++;
         }
-        else if ((!x1HasNext) || (x2HasNext && (x2->symbols[i_x2] < x1->symbols[i_x1]))) {
+        else if (step == ARPRA_MERGE_X2) {
             // y[i] = (x1[0] * x2[i])
             yy.symbols[i_y] = x2->symbols[i_x2];
-            ARPRA_MPFR_RNDERR_MUL(error, MPFR_RNDN, &(yy.deviations[i_y]), &(x1->centre), &(x2->deviations[i_x2]));
-            x2HasNext = ++i_x2 < x2->nTerms;
+            ARPRA_MPFR_RNDACC_MUL(&rnderr, MPFR_RNDN, &(yy.deviations[i_y]), &(x1->centre), &(x2->deviations[i_x2]));
+            i_x2++;
         }
         else {
             // y[i] = (x2[0] * x1[i]) + (x1[0] * x2[i])
             yy.symbols[i_y] = x1->symbols[i_x1];
-            ARPRA_MPFR_RNDERR_FMMA(error, MPFR_RNDN, &(yy.deviations[i_y]), &(x2->centre), &(x1->deviations[i_x1]), &(x1->centre), &(x2->deviations[i_x2]));
-            x1HasNext = ++i_x1 < x1->nTerms;
-            x2HasNext = ++i_x2 < x2->nTerms;
+            ARPRA_MPFR_RNDACC_FMMA(&rnderr, MPFR_RNDN, &(yy.deviations[i_y]), &(x2->centre), &(x1->deviations[i_x1]), &(x1->centre), &(x2->deviations[i_x2]));
+            i_x1++;
+            i_x2++;
         }
-        i_y++;
+        arpra_helper_sumabs_add(&radius, &(yy.deviations[i_y]));
     }
 
+    // Rounding error.
+    arpra_helper_rnderr_get(error, &rnderr);
+
     // Approximation error.
     switch (mul_method) {
     case ARPRA_MUL_TRIVIAL:
@@ -255,8 +277,10 @@ void arpra_mul (arpra_range *y, const arpra_range *x1, const arpra_range *x2)
     }
 
     // Store new deviation term.
-    yy.symbols[i_y] = arpra_helper_next_symbol();
+    yy.symbols[i_y] = arpra_helper_next_symbol(ARPRA_SYMBOL_APPROXIMATION);
     yy.deviations[i_y] = *error;
+    arpra_helper_sumabs_add(&radius, &(yy.deviations[i_y]));
+    arpra_helper_sumabs_get(&(yy.radius), &radius);
     yy.nTerms = i_y + 1;
 
     // MPFI multiplication
@@ -275,4 +299,5 @@ void arpra_mul (arpra_range *y, const arpra_range *x1, const arpra_range *x2)
     mpfi_clear(ia_range);
     arpra_clear(y);
     *y = yy;
+    arpra_helper_pop_precision(prec_prev);
 }
@@ -41,6 +41,12 @@ void arpra_neg (arpra_range *y, const arpra_range *x1)
         return;
     }
 
+    // Interval method.
+    if (arpra_helper_range_method(y) == ARPRA_IA) {
+        arpra_helper_ia_1(y, mpfi_neg, x1);
+        return;
+    }
+
     // Initialise vars.
     mpfi_init2(ia_range, y->precision);
     mpfi_init2(alpha, 2);
@@ -56,14 +62,8 @@ void arpra_neg (arpra_range *y, const arpra_range *x1)
     // y = - x1
     arpra_helper_affine_1(y, x1, alpha, gamma, delta);
 
-    // Compute true_range.
-    arpra_helper_compute_range(y);
-
-    // Mix with IA range, and trim error term.
-    arpra_helper_mix_trim(y, ia_range);
-
-    // Check for NaN and Inf.
-    arpra_helper_check_result(y);
+    // Compute true_range, or defer it until it is needed.
+    arpra_helper_defer_range(y, ia_range);
 
     // Clear vars.
     mpfi_clear(ia_range);
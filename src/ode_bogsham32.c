@@ -42,7 +42,6 @@ typedef struct bogsham32_scratch_struct
     arpra_range bh_2[bogsham32_stages];
     arpra_range ch[bogsham32_stages];
     arpra_range temp_t[bogsham32_stages];
-    arpra_range temp_x;
 } bogsham32_scratch;
 
 static void bogsham32_compute_constants (arpra_ode_stepper *stepper, const arpra_prec prec)
@@ -192,7 +191,6 @@ static void bogsham32_init (arpra_ode_stepper *stepper, arpra_ode_system *system
         arpra_init2(&(scratch->ch[k_i]), prec_internal);
         arpra_init2(&(scratch->temp_t[k_i]), prec_internal);
     }
-    arpra_init2(&(scratch->temp_x), prec_internal);
 
     // Set stepper parameters.
     stepper->method = arpra_ode_bogsham32;
@@ -236,7 +234,6 @@ static void bogsham32_clear (arpra_ode_stepper *stepper)
         arpra_clear(&(scratch->ch[k_i]));
         arpra_clear(&(scratch->temp_t[k_i]));
     }
-    arpra_clear(&(scratch->temp_x));
 
     // Free scratch memory.
     for (k_i = 0; k_i < bogsham32_stages; k_i++) {
@@ -254,7 +251,7 @@ static void bogsham32_step (arpra_ode_stepper *stepper, const arpra_range *h)
 {
     arpra_uint x_grp, x_dim, k_i, k_j;
     arpra_prec prec_t, prec_x;
-    arpra_range **x_old, **x_sum;
+    arpra_range **x_old;
     arpra_ode_system *system;
     bogsham32_scratch *scratch;
 
@@ -293,54 +290,51 @@ static void bogsham32_step (arpra_ode_stepper *stepper, const arpra_range *h)
         x_old = (k_i == 0) ? system->x : scratch->x_new_3;
 
         // x(t + c_i h) = x(t) + a_i0 h k[0] + ... + a_is h k[s]
-        for (x_grp = 0; x_grp < system->grps; x_grp++) {
-            for (x_dim = 0; x_dim < system->dims[x_grp]; x_dim++) {
-                prec_x = arpra_get_precision(&(system->x[x_grp][x_dim]));
-                arpra_set_precision(&(scratch->temp_x), prec_x);
-                for (k_j = 0; k_j < k_i; k_j++) {
-                    x_sum = (k_j == 0) ? system->x : scratch->x_new_3;
-                    arpra_mul(&(scratch->temp_x), &(scratch->ah[k_i][k_j]), &(scratch->k[k_j][x_grp][x_dim]));
-                    arpra_add(&(scratch->x_new_3[x_grp][x_dim]), &(x_sum[x_grp][x_dim]), &(scratch->temp_x));
-                }
-            }
-        }
+        arpra_helper_ode_sum(stepper, scratch->x_new_3, system->x, scratch->ah[k_i], scratch->k, k_i);
 
         // k[i] = f(t + c_i h, x(t) + a_i0 h k[0] + ... + a_is h k[s])
-        for (x_grp = 0; x_grp < system->grps; x_grp++) {
-            for (x_dim = 0; x_dim < system->dims[x_grp]; x_dim++) {
-                system->f[x_grp](&(scratch->k[k_i][x_grp][x_dim]), system->params[x_grp],
-                                 &(scratch->temp_t[k_i]), (const arpra_range **) x_old, x_grp, x_dim);
-            }
-        }
+        arpra_helper_ode_f(stepper, scratch->k[k_i], &(scratch->temp_t[k_i]), (const arpra_range **) x_old);
     }
 
     // Compute second-order approximation.
-    for (x_grp = 0; x_grp < system->grps; x_grp++) {
-        for (x_dim = 0; x_dim < system->dims[x_grp]; x_dim++) {
-            prec_x = arpra_get_precision(&(system->x[x_grp][x_dim]));
-            arpra_set_precision(&(scratch->temp_x), prec_x);
-            for (k_j = 0; k_j < bogsham32_stages; k_j++) {
-                x_sum = (k_j == 0) ? system->x : scratch->x_new_2;
-                arpra_mul(&(scratch->temp_x), &(scratch->bh_2[k_j]), &(scratch->k[k_j][x_grp][x_dim]));
-                arpra_add(&(scratch->x_new_2[x_grp][x_dim]), &(x_sum[x_grp][x_dim]), &(scratch->temp_x));
-            }
-        }
-    }
+    arpra_helper_ode_sum(stepper, scratch->x_new_2, system->x, scratch->bh_2, scratch->k, bogsham32_stages);
 
     // Advance system.
     arpra_add(system->t, system->t, h);
     for (x_grp = 0; x_grp < system->grps; x_grp++) {
         for (x_dim = 0; x_dim < system->dims[x_grp]; x_dim++) {
-            arpra_set(&(system->x[x_grp][x_dim]), &(scratch->x_new_3[x_grp][x_dim]));
+            arpra_swap(&(system->x[x_grp][x_dim]), &(scratch->x_new_3[x_grp][x_dim]));
         }
     }
 }
 
+static arpra_uint bogsham32_consts (arpra_ode_stepper *stepper, arpra_range **list)
+{
+    bogsham32_scratch *scratch;
+    arpra_uint i, n;
+
+    scratch = (bogsham32_scratch *) stepper->scratch;
+    n = (bogsham32_stages * (bogsham32_stages - 1)) / 2;
+    if (list != NULL) {
+        for (i = 0; i < n; i++) {
+            list[i] = &(scratch->_a[i]);
+        }
+        for (i = 0; i < bogsham32_stages; i++) {
+            list[n + (3 * i)] = &(scratch->b_3[i]);
+            list[n + (3 * i) + 1] = &(scratch->b_2[i]);
+            list[n + (3 * i) + 2] = &(scratch->c[i]);
+        }
+    }
+
+    return n + (3 * bogsham32_stages);
+}
+
 static const arpra_ode_method bogsham32 =
 {
     .init = &bogsham32_init,
     .clear = &bogsham32_clear,
     .step = &bogsham32_step,
+    .consts = &bogsham32_consts,
     .stages = bogsham32_stages,
 };
 
@@ -42,7 +42,6 @@ typedef struct dopri54_scratch_struct
     arpra_range bh_4[dopri54_stages];
     arpra_range ch[dopri54_stages];
     arpra_range temp_t[dopri54_stages];
-    arpra_range temp_x;
 } dopri54_scratch;
 
 static void dopri54_compute_constants (arpra_ode_stepper *stepper, const arpra_prec prec)
@@ -283,7 +282,6 @@ static void dopri54_init (arpra_ode_stepper *stepper, arpra_ode_system *system)
         arpra_init2(&(scratch->ch[k_i]), prec_internal);
         arpra_init2(&(scratch->temp_t[k_i]), prec_internal);
     }
-    arpra_init2(&(scratch->temp_x), prec_internal);
 
     // Set stepper parameters.
     stepper->method = arpra_ode_dopri54;
@@ -327,7 +325,6 @@ static void dopri54_clear (arpra_ode_stepper *stepper)
         arpra_clear(&(scratch->ch[k_i]));
         arpra_clear(&(scratch->temp_t[k_i]));
     }
-    arpra_clear(&(scratch->temp_x));
 
     // Free scratch memory.
     for (k_i = 0; k_i < dopri54_stages; k_i++) {
@@ -345,7 +342,7 @@ static void dopri54_step (arpra_ode_stepper *stepper, const arpra_range *h)
 {
     arpra_uint x_grp, x_dim, k_i, k_j;
     arpra_prec prec_t, prec_x;
-    arpra_range **x_old, **x_sum;
+    arpra_range **x_old;
     arpra_ode_system *system;
     dopri54_scratch *scratch;
 
@@ -384,54 +381,51 @@ static void dopri54_step (arpra_ode_stepper *stepper, const arpra_range *h)
         x_old = (k_i == 0) ? system->x : scratch->x_new_5;
 
         // x(t + c_i h) = x(t) + a_i0 h k[0] + ... + a_is h k[s]
-        for (x_grp = 0; x_grp < system->grps; x_grp++) {
-            for (x_dim = 0; x_dim < system->dims[x_grp]; x_dim++) {
-                prec_x = arpra_get_precision(&(system->x[x_grp][x_dim]));
-                arpra_set_precision(&(scratch->temp_x), prec_x);
-                for (k_j = 0; k_j < k_i; k_j++) {
-                    x_sum = (k_j == 0) ? system->x : scratch->x_new_5;
-                    arpra_mul(&(scratch->temp_x), &(scratch->ah[k_i][k_j]), &(scratch->k[k_j][x_grp][x_dim]));
-                    arpra_add(&(scratch->x_new_5[x_grp][x_dim]), &(x_sum[x_grp][x_dim]), &(scratch->temp_x));
-                }
-            }
-        }
+        arpra_helper_ode_sum(stepper, scratch->x_new_5, system->x, scratch->ah[k_i], scratch->k, k_i);
 
         // k[i] = f(t + c_i h, x(t) + a_i0 h k[0] + ... + a_is h k[s])
-        for (x_grp = 0; x_grp < system->grps; x_grp++) {
-            for (x_dim = 0; x_dim < system->dims[x_grp]; x_dim++) {
-                system->f[x_grp](&(scratch->k[k_i][x_grp][x_dim]), system->params[x_grp],
-                                 &(scratch->temp_t[k_i]), (const arpra_range **) x_old, x_grp, x_dim);
-            }
-        }
+        arpra_helper_ode_f(stepper, scratch->k[k_i], &(scratch->temp_t[k_i]), (const arpra_range **) x_old);
     }
 
     // Compute fourth-order approximation.
-    for (x_grp = 0; x_grp < system->grps; x_grp++) {
-        for (x_dim = 0; x_dim < system->dims[x_grp]; x_dim++) {
-            prec_x = arpra_get_precision(&(system->x[x_grp][x_dim]));
-            arpra_set_precision(&(scratch->temp_x), prec_x);
-            for (k_j = 0; k_j < dopri54_stages; k_j++) {
-                x_sum = (k_j == 0) ? system->x : scratch->x_new_4;
-                arpra_mul(&(scratch->temp_x), &(scratch->bh_4[k_j]), &(scratch->k[k_j][x_grp][x_dim]));
-                arpra_add(&(scratch->x_new_4[x_grp][x_dim]), &(x_sum[x_grp][x_dim]), &(scratch->temp_x));
-            }
-        }
-    }
+    arpra_helper_ode_sum(stepper, scratch->x_new_4, system->x, scratch->bh_4, scratch->k, dopri54_stages);
 
     // Advance system.
     arpra_add(system->t, system->t, h);
     for (x_grp = 0; x_grp < system->grps; x_grp++) {
         for (x_dim = 0; x_dim < system->dims[x_grp]; x_dim++) {
-            arpra_set(&(system->x[x_grp][x_dim]), &(scratch->x_new_5[x_grp][x_dim]));
+            arpra_swap(&(system->x[x_grp][x_dim]), &(scratch->x_new_5[x_grp][x_dim]));
         }
     }
 }
 
+static arpra_uint dopri54_consts (arpra_ode_stepper *stepper, arpra_range **list)
+{
+    dopri54_scratch *scratch;
+    arpra_uint i, n;
+
+    scratch = (dopri54_scratch *) stepper->scratch;
+    n = (dopri54_stages * (dopri54_stages - 1)) / 2;
+    if (list != NULL) {
+        for (i = 0; i < n; i++) {
+            list[i] = &(scratch->_a[i]);
+        }
+        for (i = 0; i < dopri54_stages; i++) {
+            list[n + (3 * i)] = &(scratch->b_5[i]);
+            list[n + (3 * i) + 1] = &(scratch->b_4[i]);
+            list[n + (3 * i) + 2] = &(scratch->c[i]);
+        }
+    }
+
+    return n + (3 * dopri54_stages);
+}
+
 static const arpra_ode_method dopri54 =
 {
     .init = &dopri54_init,
     .clear = &dopri54_clear,
     .step = &dopri54_step,
+    .consts = &dopri54_consts,
     .stages = dopri54_stages,
 };
 
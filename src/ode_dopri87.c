@@ -42,7 +42,6 @@ typedef struct dopri87_scratch_struct
     arpra_range bh_7[dopri87_stages];
     arpra_range ch[dopri87_stages];
     arpra_range temp_t[dopri87_stages];
-    arpra_range temp_x;
 } dopri87_scratch;
 
 static void dopri87_compute_constants (arpra_ode_stepper *stepper, const arpra_prec prec)
@@ -540,7 +539,6 @@ static void dopri87_init (arpra_ode_stepper *stepper, arpra_ode_system *system)
         arpra_init2(&(scratch->ch[k_i]), prec_internal);
         arpra_init2(&(scratch->temp_t[k_i]), prec_internal);
     }
-    arpra_init2(&(scratch->temp_x), prec_internal);
 
     // Set stepper parameters.
     stepper->method = arpra_ode_dopri87;
@@ -584,7 +582,6 @@ static void dopri87_clear (arpra_ode_stepper *stepper)
         arpra_clear(&(scratch->ch[k_i]));
         arpra_clear(&(scratch->temp_t[k_i]));
     }
-    arpra_clear(&(scratch->temp_x));
 
     // Free scratch memory.
     for (k_i = 0; k_i < dopri87_stages; k_i++) {
@@ -602,7 +599,7 @@ static void dopri87_step (arpra_ode_stepper *stepper, const arpra_range *h)
 {
     arpra_uint x_grp, x_dim, k_i, k_j;
     arpra_prec prec_t, prec_x;
-    arpra_range **x_old, **x_sum;
+    arpra_range **x_old;
     arpra_ode_system *system;
     dopri87_scratch *scratch;
 
@@ -641,67 +638,54 @@ static void dopri87_step (arpra_ode_stepper *stepper, const arpra_range *h)
         x_old = (k_i == 0) ? system->x : scratch->x_new_8;
 
         // x(t + c_i h) = x(t) + a_i0 h k[0] + ... + a_is h k[s]
-        for (x_grp = 0; x_grp < system->grps; x_grp++) {
-            for (x_dim = 0; x_dim < system->dims[x_grp]; x_dim++) {
-                prec_x = arpra_get_precision(&(system->x[x_grp][x_dim]));
-                arpra_set_precision(&(scratch->temp_x), prec_x);
-                for (k_j = 0; k_j < k_i; k_j++) {
-                    x_sum = (k_j == 0) ? system->x : scratch->x_new_8;
-                    arpra_mul(&(scratch->temp_x), &(scratch->ah[k_i][k_j]), &(scratch->k[k_j][x_grp][x_dim]));
-                    arpra_add(&(scratch->x_new_8[x_grp][x_dim]), &(x_sum[x_grp][x_dim]), &(scratch->temp_x));
-                }
-            }
-        }
+        arpra_helper_ode_sum(stepper, scratch->x_new_8, system->x, scratch->ah[k_i], scratch->k, k_i);
 
         // k[i] = f(t + c_i h, x(t) + a_i0 h k[0] + ... + a_is h k[s])
-        for (x_grp = 0; x_grp < system->grps; x_grp++) {
-            for (x_dim = 0; x_dim < system->dims[x_grp]; x_dim++) {
-                system->f[x_grp](&(scratch->k[k_i][x_grp][x_dim]), system->params[x_grp],
-                                 &(scratch->temp_t[k_i]), (const arpra_range **) x_old, x_grp, x_dim);
-            }
-        }
+        arpra_helper_ode_f(stepper, scratch->k[k_i], &(scratch->temp_t[k_i]), (const arpra_range **) x_old);
     }
 
     // Compute eighth-order approximation.
-    for (x_grp = 0; x_grp < system->grps; x_grp++) {
-        for (x_dim = 0; x_dim < system->dims[x_grp]; x_dim++) {
-            prec_x = arpra_get_precision(&(system->x[x_grp][x_dim]));
-            arpra_set_precision(&(scratch->temp_x), prec_x);
-            for (k_j = 0; k_j < dopri87_stages; k_j++) {
-                x_sum = (k_j == 0) ? system->x : scratch->x_new_8;
-                arpra_mul(&(scratch->temp_x), &(scratch->bh_8[k_j]), &(scratch->k[k_j][x_grp][x_dim]));
-                arpra_add(&(scratch->x_new_8[x_grp][x_dim]), &(x_sum[x_grp][x_dim]), &(scratch->temp_x));
-            }
-        }
-    }
+    arpra_helper_ode_sum(stepper, scratch->x_new_8, system->x, scratch->bh_8, scratch->k, dopri87_stages);
 
     // Compute seventh-order approximation.
-    for (x_grp = 0; x_grp < system->grps; x_grp++) {
-        for (x_dim = 0; x_dim < system->dims[x_grp]; x_dim++) {
-            prec_x = arpra_get_precision(&(system->x[x_grp][x_dim]));
-            arpra_set_precision(&(scratch->temp_x), prec_x);
-            for (k_j = 0; k_j < dopri87_stages; k_j++) {
-                x_sum = (k_j == 0) ? system->x : scratch->x_new_7;
-                arpra_mul(&(scratch->temp_x), &(scratch->bh_7[k_j]), &(scratch->k[k_j][x_grp][x_dim]));
-                arpra_add(&(scratch->x_new_7[x_grp][x_dim]), &(x_sum[x_grp][x_dim]), &(scratch->temp_x));
-            }
-        }
-    }
+    arpra_helper_ode_sum(stepper, scratch->x_new_7, system->x, scratch->bh_7, scratch->k, dopri87_stages);
 
     // Advance system.
     arpra_add(system->t, system->t, h);
     for (x_grp = 0; x_grp < system->grps; x_grp++) {
         for (x_dim = 0; x_dim < system->dims[x_grp]; x_dim++) {
-            arpra_set(&(system->x[x_grp][x_dim]), &(scratch->x_new_8[x_grp][x_dim]));
+            arpra_swap(&(system->x[x_grp][x_dim]), &(scratch->x_new_8[x_grp][x_dim]));
         }
     }
 }
 
+static arpra_uint dopri87_consts (arpra_ode_stepper *stepper, arpra_range **list)
+{
+    dopri87_scratch *scratch;
+    arpra_uint i, n;
+
+    scratch = (dopri87_scratch *) stepper->scratch;
+    n = (dopri87_stages * (dopri87_stages - 1)) / 2;
+    if (list != NULL) {
+        for (i = 0; i < n; i++) {
+            list[i] = &(scratch->_a[i]);
+        }
+        for (i = 0; i < dopri87_stages; i++) {
+            list[n + (3 * i)] = &(scratch->b_8[i]);
+            list[n + (3 * i) + 1] = &(scratch->b_7[i]);
+            list[n + (3 * i) + 2] = &(scratch->c[i]);
+        }
+    }
+
+    return n + (3 * dopri87_stages);
+}
+
 static const arpra_ode_method dopri87 =
 {
     .init = &dopri87_init,
     .clear = &dopri87_clear,
     .step = &dopri87_step,
+    .consts = &dopri87_consts,
     .stages = dopri87_stages,
 };
 
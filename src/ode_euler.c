@@ -29,13 +29,12 @@ typedef struct euler_scratch_struct
     arpra_range **k_0;
     arpra_range *_x_new;
     arpra_range **x_new;
-    arpra_range temp_x;
 } euler_scratch;
 
 static void euler_init (arpra_ode_stepper *stepper, arpra_ode_system *system)
 {
     arpra_uint x_grp, x_dim, state_size;
-    arpra_prec prec_x, prec_internal;
+    arpra_prec prec_x;
     euler_scratch *scratch;
 
     // Allocate scratch memory.
@@ -49,7 +48,6 @@ static void euler_init (arpra_ode_stepper *stepper, arpra_ode_system *system)
     scratch->x_new = malloc(system->grps * sizeof(arpra_range *));
 
     // Initialise scratch memory.
-    prec_internal = arpra_get_internal_precision();
     scratch->k_0[0] = scratch->_k_0;
     scratch->x_new[0] = scratch->_x_new;
     for (x_grp = 1; x_grp < system->grps; x_grp++) {
@@ -63,7 +61,6 @@ static void euler_init (arpra_ode_stepper *stepper, arpra_ode_system *system)
             arpra_init2(&(scratch->x_new[x_grp][x_dim]), prec_x);
         }
     }
-    arpra_init2(&(scratch->temp_x), prec_internal);
 
     // Set stepper parameters.
     stepper->method = arpra_ode_euler;
@@ -88,7 +85,6 @@ static void euler_clear (arpra_ode_stepper *stepper)
             arpra_clear(&(scratch->x_new[x_grp][x_dim]));
         }
     }
-    arpra_clear(&(scratch->temp_x));
 
     // Free scratch memory.
     free(scratch->_k_0);
@@ -118,28 +114,16 @@ static void euler_step (arpra_ode_stepper *stepper, const arpra_range *h)
     }
 
     // k[0] = f(t, x(t))
-    for (x_grp = 0; x_grp < system->grps; x_grp++) {
-        for (x_dim = 0; x_dim < system->dims[x_grp]; x_dim++) {
-            system->f[x_grp](&(scratch->k_0[x_grp][x_dim]), system->params[x_grp],
-                             system->t, (const arpra_range **) system->x, x_grp, x_dim);
-        }
-    }
+    arpra_helper_ode_f(stepper, scratch->k_0, system->t, (const arpra_range **) system->x);
 
     // x(t + h) = x(t) + h k[0]
-    for (x_grp = 0; x_grp < system->grps; x_grp++) {
-        for (x_dim = 0; x_dim < system->dims[x_grp]; x_dim++) {
-            prec_x = arpra_get_precision(&(system->x[x_grp][x_dim]));
-            arpra_set_precision(&(scratch->temp_x), prec_x);
-            arpra_mul(&(scratch->temp_x), h, &(scratch->k_0[x_grp][x_dim]));
-            arpra_add(&(scratch->x_new[x_grp][x_dim]), &(system->x[x_grp][x_dim]), &(scratch->temp_x));
-        }
-    }
+    arpra_helper_ode_sum(stepper, scratch->x_new, system->x, h, &(scratch->k_0), 1);
 
     // Advance system.
     arpra_add(system->t, system->t, h);
     for (x_grp = 0; x_grp < system->grps; x_grp++) {
         for (x_dim = 0; x_dim < system->dims[x_grp]; x_dim++) {
-            arpra_set(&(system->x[x_grp][x_dim]), &(scratch->x_new[x_grp][x_dim]));
+            arpra_swap(&(system->x[x_grp][x_dim]), &(scratch->x_new[x_grp][x_dim]));
         }
     }
 }
@@ -25,6 +25,9 @@ void arpra_ode_stepper_init (arpra_ode_stepper *stepper, arpra_ode_system *syste
                              const arpra_ode_method *method)
 {
     method->init(stepper, system);
+    stepper->reduce = NULL;
+    stepper->reduce_epoch = 0;
+    stepper->steps = 0;
 }
 
 void arpra_ode_stepper_clear (arpra_ode_stepper *stepper)
@@ -34,5 +37,59 @@ void arpra_ode_stepper_clear (arpra_ode_stepper *stepper)
 
 void arpra_ode_stepper_step (arpra_ode_stepper *stepper, const arpra_range *h)
 {
+    // Terms with symbols from reduce_epoch onwards are new in this step.
+    stepper->reduce_epoch = arpra_helper_get_symbol_count();
     stepper->method->step(stepper, h);
+    if (stepper->reduce != NULL) {
+        arpra_helper_ode_reduce(stepper, stepper->system->x, 0);
+    }
+    stepper->steps++;
+}
+
+void arpra_ode_stepper_set_reduce (arpra_ode_stepper *stepper, const arpra_ode_reduce *reduce)
+{
+    stepper->reduce = reduce;
+}
+
+/*
+ * Renumber the symbols of the system state and time, the constants of the
+ * step method, and the n extra ranges in x, with arpra_renumber_symbols.
+ * The extra ranges should include the step size and every parameter range
+ * used by the system.
+ */
+
+void arpra_ode_stepper_renumber (arpra_ode_stepper *stepper, arpra_range **x, arpra_uint n)
+{
+    arpra_ode_system *system;
+    arpra_range **list;
+    arpra_uint x_grp, x_dim, i, n_consts;
+
+    system = stepper->system;
+    n_consts = 0;
+    if (stepper->method->consts != NULL) {
+        n_consts = stepper->method->consts(stepper, NULL);
+    }
+    for (x_grp = 0, i = n_consts + n + 1; x_grp < system->grps; x_grp++) {
+        i += system->dims[x_grp];
+    }
+    list = malloc(i * sizeof(arpra_range *));
+
+    // List all live ranges.
+    if (n_consts > 0) {
+        stepper->method->consts(stepper, list);
+    }
+    for (i = n_consts; i < (n_consts + n); i++) {
+        list[i] = x[i - n_consts];
+    }
+    list[i++] = system->t;
+    for (x_grp = 0; x_grp < system->grps; x_grp++) {
+        for (x_dim = 0; x_dim < system->dims[x_grp]; x_dim++) {
+            list[i++] = &(system->x[x_grp][x_dim]);
+        }
+    }
+
+    arpra_renumber_symbols(list, i);
+    stepper->reduce_epoch = arpra_helper_get_symbol_count();
+
+    free(list);
 }
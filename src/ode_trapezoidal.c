@@ -34,7 +34,6 @@ typedef struct trapezoidal_scratch_struct
     arpra_range half;
     arpra_range half_h;
     arpra_range temp_t;
-    arpra_range temp_x;
 } trapezoidal_scratch;
 
 static void trapezoidal_init (arpra_ode_stepper *stepper, arpra_ode_system *system)
@@ -76,7 +75,6 @@ static void trapezoidal_init (arpra_ode_stepper *stepper, arpra_ode_system *syst
     arpra_init2(&(scratch->half), 2);
     arpra_init2(&(scratch->half_h), prec_internal);
     arpra_init2(&(scratch->temp_t), prec_internal);
-    arpra_init2(&(scratch->temp_x), prec_internal);
 
     // Set stepper parameters.
     stepper->method = arpra_ode_trapezoidal;
@@ -108,7 +106,6 @@ static void trapezoidal_clear (arpra_ode_stepper *stepper)
     arpra_clear(&(scratch->half));
     arpra_clear(&(scratch->half_h));
     arpra_clear(&(scratch->temp_t));
-    arpra_clear(&(scratch->temp_x));
 
     // Free scratch memory.
     free(scratch->_k_0);
@@ -146,57 +143,45 @@ static void trapezoidal_step (arpra_ode_stepper *stepper, const arpra_range *h)
     arpra_add(&(scratch->temp_t), system->t, h);
 
     // k[0] = f(t, x(t))
-    for (x_grp = 0; x_grp < system->grps; x_grp++) {
-        for (x_dim = 0; x_dim < system->dims[x_grp]; x_dim++) {
-            system->f[x_grp](&(scratch->k_0[x_grp][x_dim]), system->params[x_grp],
-                             system->t, (const arpra_range **) system->x, x_grp, x_dim);
-        }
-    }
+    arpra_helper_ode_f(stepper, scratch->k_0, system->t, (const arpra_range **) system->x);
 
     // x(t + h) = x(t) + h k[0]
-    for (x_grp = 0; x_grp < system->grps; x_grp++) {
-        for (x_dim = 0; x_dim < system->dims[x_grp]; x_dim++) {
-            prec_x = arpra_get_precision(&(system->x[x_grp][x_dim]));
-            arpra_set_precision(&(scratch->temp_x), prec_x);
-            arpra_mul(&(scratch->temp_x), h, &(scratch->k_0[x_grp][x_dim]));
-            arpra_add(&(scratch->x_new[x_grp][x_dim]), &(system->x[x_grp][x_dim]), &(scratch->temp_x));
-        }
-    }
+    arpra_helper_ode_sum(stepper, scratch->x_new, system->x, h, &(scratch->k_0), 1);
 
     // k[1] = f(t + h, x(t) + h k[0])
-    for (x_grp = 0; x_grp < system->grps; x_grp++) {
-        for (x_dim = 0; x_dim < system->dims[x_grp]; x_dim++) {
-            system->f[x_grp](&(scratch->k_1[x_grp][x_dim]), system->params[x_grp],
-                             &(scratch->temp_t), (const arpra_range **) scratch->x_new, x_grp, x_dim);
-        }
-    }
+    arpra_helper_ode_f(stepper, scratch->k_1, &(scratch->temp_t), (const arpra_range **) scratch->x_new);
 
     // x(t + h) = x(t) + 1/2 h k[0] + 1/2 h k[1]
-    for (x_grp = 0; x_grp < system->grps; x_grp++) {
-        for (x_dim = 0; x_dim < system->dims[x_grp]; x_dim++) {
-            prec_x = arpra_get_precision(&(system->x[x_grp][x_dim]));
-            arpra_set_precision(&(scratch->temp_x), prec_x);
-            arpra_mul(&(scratch->temp_x), &(scratch->half_h), &(scratch->k_0[x_grp][x_dim]));
-            arpra_add(&(scratch->x_new[x_grp][x_dim]), &(system->x[x_grp][x_dim]), &(scratch->temp_x));
-            arpra_mul(&(scratch->temp_x), &(scratch->half_h), &(scratch->k_1[x_grp][x_dim]));
-            arpra_add(&(scratch->x_new[x_grp][x_dim]), &(scratch->x_new[x_grp][x_dim]), &(scratch->temp_x));
-        }
-    }
+    arpra_helper_ode_sum(stepper, scratch->x_new, system->x, &(scratch->half_h), &(scratch->k_0), 1);
+    arpra_helper_ode_sum(stepper, scratch->x_new, scratch->x_new, &(scratch->half_h), &(scratch->k_1), 1);
 
     // Advance system.
     arpra_add(system->t, system->t, h);
     for (x_grp = 0; x_grp < system->grps; x_grp++) {
         for (x_dim = 0; x_dim < system->dims[x_grp]; x_dim++) {
-            arpra_set(&(system->x[x_grp][x_dim]), &(scratch->x_new[x_grp][x_dim]));
+            arpra_swap(&(system->x[x_grp][x_dim]), &(scratch->x_new[x_grp][x_dim]));
         }
     }
 }
 
+static arpra_uint trapezoidal_consts (arpra_ode_stepper *stepper, arpra_range **list)
+{
+    trapezoidal_scratch *scratch;
+
+    scratch = (trapezoidal_scratch *) stepper->scratch;
+    if (list != NULL) {
+        list[0] = &(scratch->half);
+    }
+
+    return 1;
+}
+
 static const arpra_ode_method trapezoidal =
 {
     .init = &trapezoidal_init,
     .clear = &trapezoidal_clear,
     .step = &trapezoidal_step,
+    .consts = &trapezoidal_consts,
     .stages = trapezoidal_stages,
 };
 
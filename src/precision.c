@@ -28,12 +28,62 @@ arpra_prec arpra_get_precision (const arpra_range *x1)
 
 void arpra_set_precision (arpra_range *y, arpra_prec prec)
 {
-    arpra_prec prec_internal;
+    mpfi_t ia_range;
+    mpfi_t alpha, gamma;
+    mpfr_t delta;
 
-    y->precision = prec;
-    prec_internal = arpra_get_internal_precision();
-    mpfr_set_prec(&(y->centre), prec_internal);
-    mpfr_set_prec(&(y->radius), prec_internal);
+    // Nothing to do if the precision is unchanged.
+    if (y->precision == prec) return;
+
+    // Compute the range of y, if it is dirty.
+    arpra_helper_update_range(y);
+
+    // Round true_range outward to the new precision.
+    mpfi_init2(ia_range, prec);
+    mpfi_set(ia_range, &(y->true_range));
     mpfi_set_prec(&(y->true_range), prec);
-    arpra_helper_clear_terms(y);
+    mpfi_set(&(y->true_range), ia_range);
+    y->precision = prec;
+
+    // Handle domain violations.
+    if (arpra_nan_p(y)) {
+        arpra_set_nan(y);
+        mpfi_clear(ia_range);
+        return;
+    }
+    if (arpra_inf_p(y)) {
+        arpra_set_inf(y);
+        mpfi_clear(ia_range);
+        return;
+    }
+
+    // Round the centre and deviation terms if they exceed the internal precision.
+    if (mpfr_get_prec(&(y->centre)) > arpra_helper_range_precision(y)) {
+        mpfi_init2(alpha, 2);
+        mpfi_init2(gamma, 2);
+        mpfr_init2(delta, 2);
+        mpfi_set_si(alpha, 1);
+        mpfi_set_si(gamma, 0);
+        mpfr_set_zero(delta, 1);
+
+        // y = y, with rounding error in a new deviation term.
+        arpra_helper_affine_1(y, y, alpha, gamma, delta);
+
+        mpfi_clear(alpha);
+        mpfi_clear(gamma);
+        mpfr_clear(delta);
+    }
+
+    // Compute true_range. This adds to the last deviation term in place.
+    arpra_helper_own_terms(y);
+    arpra_helper_compute_range(y);
+
+    // Mix with IA range, and trim error term.
+    arpra_helper_mix_trim(y, ia_range);
+
+    // Check for NaN and Inf.
+    arpra_helper_check_result(y);
+
+    // Clear vars.
+    mpfi_clear(ia_range);
 }
@@ -38,21 +38,25 @@ int arpra_bounded_p (const arpra_range *x1)
 
 int arpra_zero_p (const arpra_range *x1)
 {
+    arpra_helper_update_range(x1);
     return mpfr_zero_p(&(x1->true_range.left)) && mpfr_zero_p(&(x1->true_range.right));
 }
 
 int arpra_has_zero_p (const arpra_range *x1)
 {
+    arpra_helper_update_range(x1);
     return !mpfi_nan_p(&(x1->true_range))
            && (mpfr_sgn(&(x1->true_range.left)) <= 0) && (mpfr_sgn(&(x1->true_range.right)) >= 0);
 }
 
 int arpra_has_pos_p (const arpra_range *x1)
 {
+    arpra_helper_update_range(x1);
     return mpfr_sgn(&(x1->true_range.right)) > 0;
 }
 
 int arpra_has_neg_p (const arpra_range *x1)
 {
+    arpra_helper_update_range(x1);
     return mpfr_sgn(&(x1->true_range.left)) < 0;
 }
@@ -32,3 +32,28 @@ void arpra_set_range_method (arpra_range_method new_range_method)
 {
     range_method = new_range_method;
 }
+
+/*
+ * A range can override the global method. Operations use the method of
+ * their result range, so an ARPRA_IA range stays an interval however its
+ * operands were computed.
+ */
+
+arpra_range_method arpra_get_local_range_method (const arpra_range *x1)
+{
+    return x1->range_method;
+}
+
+void arpra_set_local_range_method (arpra_range *y, arpra_range_method new_range_method)
+{
+    y->range_method = new_range_method;
+}
+
+arpra_range_method arpra_helper_range_method (const arpra_range *y)
+{
+    if (y->range_method == ARPRA_GLOBAL_RANGE_METHOD) {
+        return range_method;
+    }
+
+    return y->range_method;
+}
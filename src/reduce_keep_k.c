@@ -0,0 +1,246 @@
+/*
+ * reduce_keep_k.c -- Reduce all but the k largest deviation terms.
+ *
+ * Copyright 2016-2020 James Paul Turner.
+ *
+ * This file is part of the Arpra library.
+ *
+ * The Arpra library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Arpra library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with the Arpra library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "arpra-impl.h"
+
+static void swap_index (arpra_uint *a, arpra_uint *b)
+{
+    arpra_uint temp;
+
+    temp = *a;
+    *a = *b;
+    *b = temp;
+}
+
+/*
+ * Quickselect: partially order idx[0 ... n-1] so that the first k entries
+ * have the largest keys. Keys are the exponents in exp if dev is NULL, and
+ * the absolute values of dev otherwise.
+ */
+
+static int key_cmp (const mpfr_exp_t *exp, mpfr_srcptr dev, arpra_uint a, arpra_uint b)
+{
+    if (dev == NULL) {
+        return (exp[a] > exp[b]) - (exp[a] < exp[b]);
+    }
+    return mpfr_cmpabs(&(dev[a]), &(dev[b]));
+}
+
+static void select_k (arpra_uint *idx, arpra_uint n, arpra_uint k,
+                      const mpfr_exp_t *exp, mpfr_srcptr dev)
+{
+    arpra_uint lo, hi, gt, lt, i, pivot;
+    int cmp;
+
+    lo = 0;
+    hi = n;
+    while (hi - lo > 1) {
+        pivot = idx[lo + (hi - lo) / 2];
+
+        // Partition into keys greater than, equal to and less than the pivot.
+        for (i = lo, gt = lo, lt = hi; i < lt; ) {
+            cmp = key_cmp(exp, dev, idx[i], pivot);
+            if (cmp > 0) {
+                swap_index(&(idx[i]), &(idx[gt]));
+                gt++;
+                i++;
+            }
+            else if (cmp < 0) {
+                lt--;
+                swap_index(&(idx[i]), &(idx[lt]));
+            }
+            else {
+                i++;
+            }
+        }
+
+        if (k < gt) {
+            hi = gt;
+        }
+        else if (k > lt) {
+            lo = lt;
+        }
+        else {
+            break;
+        }
+    }
+}
+
+void arpra_reduce_keep_k (arpra_range *y, const arpra_range *x1, arpra_uint k)
+{
+    mpfr_t error;
+    arpra_rnderr rnderr;
+    mpfr_ptr sum_x, *sum_x_ptr;
+    mpfr_exp_t *exp, exp_k;
+    arpra_uint *idx;
+    char *keep;
+    arpra_range yy;
+    arpra_prec prec_internal, prec_deviation;
+    arpra_symbol_class class;
+    arpra_uint i_y, i_x1, n_eq, n_gt;
+
+    // Terms of protected classes are kept in addition to the k largest.
+    for (i_x1 = 0; i_x1 < x1->nTerms; i_x1++) {
+        if (!arpra_helper_reducible_p(x1->symbols[i_x1])) {
+            k++;
+        }
+    }
+
+    // Handle trivial cases.
+    if (x1->nTerms <= k) {
+        arpra_set(y, x1);
+        return;
+    }
+
+    // Domain violations:
+    // reduce(NaN) = (NaN)
+    // reduce(Inf) = (Inf)
+
+    // Handle domain violations.
+    if (arpra_nan_p(x1)) {
+        arpra_set_nan(y);
+        return;
+    }
+    if (arpra_inf_p(x1)) {
+        arpra_set_inf(y);
+        return;
+    }
+
+    // Compute the range of x1, if it is dirty.
+    arpra_helper_update_range(x1);
+
+    // Initialise vars.
+    prec_internal = arpra_get_internal_precision();
+    prec_deviation = arpra_helper_deviation_precision(y);
+    mpfr_init2(error, prec_internal);
+    arpra_init2(&yy, y->precision);
+    yy.deviation_precision = y->deviation_precision;
+    yy.internal_precision = y->internal_precision;
+    yy.range_method = y->range_method;
+    yy.wide_ops = x1->wide_ops;
+    sum_x = malloc((x1->nTerms - k + 1) * sizeof(mpfr_t));
+    sum_x_ptr = malloc((x1->nTerms - k + 1) * sizeof(mpfr_ptr));
+    exp = malloc(x1->nTerms * sizeof(mpfr_exp_t));
+    idx = malloc(x1->nTerms * sizeof(arpra_uint));
+    keep = malloc(x1->nTerms * sizeof(char));
+    mpfr_set_zero(error, 1);
+    mpfr_set_zero(&(yy.radius), 1);
+    arpra_helper_rnderr_init(&rnderr);
+    class = ARPRA_SYMBOL_ROUNDING;
+
+    // Select the k largest exponents.
+    for (i_x1 = 0; i_x1 < x1->nTerms; i_x1++) {
+        if (!arpra_helper_reducible_p(x1->symbols[i_x1])) {
+            exp[i_x1] = mpfr_get_emax() + 1;
+        }
+        else if (mpfr_zero_p(&(x1->deviations[i_x1]))) {
+            exp[i_x1] = mpfr_get_emin() - 1;
+        }
+        else {
+            exp[i_x1] = mpfr_get_exp(&(x1->deviations[i_x1]));
+        }
+        idx[i_x1] = i_x1;
+    }
+    if (k > 0) {
+        select_k(idx, x1->nTerms, k, exp, NULL);
+        exp_k = exp[idx[k - 1]];
+        for (i_x1 = 0; i_x1 < k; i_x1++) {
+            if (exp[idx[i_x1]] < exp_k) {
+                exp_k = exp[idx[i_x1]];
+            }
+        }
+    }
+    else {
+        exp_k = mpfr_get_emax() + 1;
+    }
+
+    // Keep terms above the k-th exponent, and select among terms equal to it.
+    for (i_x1 = 0, n_eq = 0, n_gt = 0; i_x1 < x1->nTerms; i_x1++) {
+        keep[i_x1] = (exp[i_x1] > exp_k);
+        if (keep[i_x1]) {
+            n_gt++;
+        }
+        else if (exp[i_x1] == exp_k) {
+            idx[n_eq++] = i_x1;
+        }
+    }
+    select_k(idx, n_eq, (k - n_gt), NULL, x1->deviations);
+    for (i_x1 = 0; i_x1 < (k - n_gt); i_x1++) {
+        keep[idx[i_x1]] = 1;
+    }
+
+    // y[0] = x1[0]
+    ARPRA_MPFR_RNDERR_SET(error, MPFR_RNDN, &(yy.centre), &(x1->centre));
+
+    // Allocate memory for deviation terms.
+    arpra_helper_alloc_terms(&yy, k + 1);
+
+    for (i_y = 0, i_x1 = 0; i_x1 < x1->nTerms; i_x1++) {
+        if (keep[i_x1]) {
+            mpfr_init2(&(yy.deviations[i_y]), prec_deviation);
+
+            // y[i] = x1[i]
+            yy.symbols[i_y] = x1->symbols[i_x1];
+            ARPRA_MPFR_RNDACC_SET(&rnderr, MPFR_RNDN, &(yy.deviations[i_y]), &(x1->deviations[i_x1]));
+            ARPRA_RADIUS_ADD(&(yy.radius), &(yy.deviations[i_y]));
+
+            i_y++;
+        }
+        else {
+            // This term will be merged.
+            sum_x[i_x1 - i_y] = x1->deviations[i_x1];
+            sum_x[i_x1 - i_y]._mpfr_sign = 1;
+            sum_x_ptr[i_x1 - i_y] = &(sum_x[i_x1 - i_y]);
+            if (ARPRA_SYMBOL_CLASS(x1->symbols[i_x1]) > class) {
+                class = ARPRA_SYMBOL_CLASS(x1->symbols[i_x1]);
+            }
+        }
+    }
+
+    // Merge deviation terms.
+    arpra_helper_rnderr_get(error, &rnderr);
+    sum_x_ptr[i_x1 - i_y] = error;
+    mpfr_sum(error, sum_x_ptr, (i_x1 - i_y + 1), MPFR_RNDU);
+
+    // Store new deviation term.
+    yy.symbols[i_y] = arpra_helper_next_symbol(class);
+    yy.deviations[i_y] = *error;
+    ARPRA_RADIUS_ADD(&(yy.radius), &(yy.deviations[i_y]));
+    yy.nTerms = i_y + 1;
+
+    // Compute true_range.
+    arpra_helper_compute_range(&yy);
+
+    // Mix with IA range, and trim error term.
+    arpra_helper_mix_trim(&yy, &(x1->true_range));
+
+    // Check for NaN and Inf.
+    arpra_helper_check_result(&yy);
+
+    // Clear vars.
+    arpra_clear(y);
+    *y = yy;
+    free(sum_x);
+    free(sum_x_ptr);
+    free(exp);
+    free(idx);
+    free(keep);
+}
@@ -24,9 +24,11 @@
 void arpra_reduce_last_n (arpra_range *y, const arpra_range *x1, arpra_uint n)
 {
     mpfr_t error;
+    arpra_rnderr rnderr;
     mpfr_ptr sum_x, *sum_x_ptr;
     arpra_range yy;
-    arpra_prec prec_internal;
+    arpra_prec prec_internal, prec_deviation;
+    arpra_symbol_class class;
     arpra_uint i_y, i_x1;
 
     // Handle trivial cases.
@@ -52,28 +54,39 @@ void arpra_reduce_last_n (arpra_range *y, const arpra_range *x1, arpra_uint n)
         return;
     }
 
+    // Compute the range of x1, if it is dirty.
+    arpra_helper_update_range(x1);
+
     // Initialise vars.
     prec_internal = arpra_get_internal_precision();
+    prec_deviation = arpra_helper_deviation_precision(y);
     mpfr_init2(error, prec_internal);
     arpra_init2(&yy, y->precision);
+    yy.deviation_precision = y->deviation_precision;
+    yy.internal_precision = y->internal_precision;
+    yy.range_method = y->range_method;
+    yy.wide_ops = x1->wide_ops;
     sum_x = malloc((n + 1) * sizeof(mpfr_t));
     sum_x_ptr = malloc((n + 1) * sizeof(mpfr_ptr));
     mpfr_set_zero(error, 1);
+    mpfr_set_zero(&(yy.radius), 1);
+    arpra_helper_rnderr_init(&rnderr);
+    class = ARPRA_SYMBOL_ROUNDING;
 
     // y[0] = x1[0]
     ARPRA_MPFR_RNDERR_SET(error, MPFR_RNDN, &(yy.centre), &(x1->centre));
 
     // Allocate memory for deviation terms.
-    yy.symbols = malloc((x1->nTerms - n + 1) * sizeof(arpra_uint));
-    yy.deviations = malloc((x1->nTerms - n + 1) * sizeof(mpfr_t));
+    arpra_helper_alloc_terms(&yy, x1->nTerms + 1);
 
     for (i_y = 0, i_x1 = 0; i_x1 < x1->nTerms; i_x1++) {
-        if (i_x1 < (x1->nTerms - n)) {
-            mpfr_init2(&(yy.deviations[i_y]), prec_internal);
+        if ((i_x1 < (x1->nTerms - n)) || !arpra_helper_reducible_p(x1->symbols[i_x1])) {
+            mpfr_init2(&(yy.deviations[i_y]), prec_deviation);
 
             // y[i] = x1[i]
             yy.symbols[i_y] = x1->symbols[i_x1];
-            ARPRA_MPFR_RNDERR_SET(error, MPFR_RNDN, &(yy.deviations[i_y]), &(x1->deviations[i_x1]));
+            ARPRA_MPFR_RNDACC_SET(&rnderr, MPFR_RNDN, &(yy.deviations[i_y]), &(x1->deviations[i_x1]));
+            ARPRA_RADIUS_ADD(&(yy.radius), &(yy.deviations[i_y]));
 
             i_y++;
         }
@@ -82,16 +95,21 @@ void arpra_reduce_last_n (arpra_range *y, const arpra_range *x1, arpra_uint n)
             sum_x[i_x1 - i_y] = x1->deviations[i_x1];
             sum_x[i_x1 - i_y]._mpfr_sign = 1;
             sum_x_ptr[i_x1 - i_y] = &(sum_x[i_x1 - i_y]);
+            if (ARPRA_SYMBOL_CLASS(x1->symbols[i_x1]) > class) {
+                class = ARPRA_SYMBOL_CLASS(x1->symbols[i_x1]);
+            }
         }
     }
 
     // Merge deviation terms.
+    arpra_helper_rnderr_get(error, &rnderr);
     sum_x_ptr[i_x1 - i_y] = error;
     mpfr_sum(error, sum_x_ptr, (i_x1 - i_y + 1), MPFR_RNDU);
 
     // Store new deviation term.
-    yy.symbols[i_y] = arpra_helper_next_symbol();
+    yy.symbols[i_y] = arpra_helper_next_symbol(class);
     yy.deviations[i_y] = *error;
+    ARPRA_RADIUS_ADD(&(yy.radius), &(yy.deviations[i_y]));
     yy.nTerms = i_y + 1;
 
     // Compute true_range.
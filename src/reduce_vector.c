@@ -0,0 +1,528 @@
+/*
+ * reduce_vector.c -- Jointly reduce the deviation terms of several ranges.
+ *
+ * Copyright 2016-2020 James Paul Turner.
+ *
+ * This file is part of the Arpra library.
+ *
+ * The Arpra library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Arpra library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with the Arpra library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "arpra-impl.h"
+
+static arpra_reduce_method reduce_method = ARPRA_DEFAULT_REDUCE_METHOD;
+
+arpra_reduce_method arpra_get_reduce_method ()
+{
+    return reduce_method;
+}
+
+void arpra_set_reduce_method (arpra_reduce_method new_reduce_method)
+{
+    reduce_method = new_reduce_method;
+}
+
+typedef struct reduce_key_struct
+{
+    int keep;
+    double key;
+    arpra_uint col;
+} reduce_key;
+
+static int symbol_cmp (const void *a, const void *b)
+{
+    arpra_symbol sa = *((const arpra_symbol *) a);
+    arpra_symbol sb = *((const arpra_symbol *) b);
+
+    return (sa > sb) - (sa < sb);
+}
+
+static int key_cmp (const void *a, const void *b)
+{
+    const reduce_key *ka = (const reduce_key *) a;
+    const reduce_key *kb = (const reduce_key *) b;
+
+    if (ka->keep != kb->keep) {
+        return ka->keep - kb->keep;
+    }
+    if (ka->key != kb->key) {
+        return (ka->key > kb->key) - (ka->key < kb->key);
+    }
+    return (ka->col > kb->col) - (ka->col < kb->col);
+}
+
+/*
+ * Cyclic Jacobi eigenvalue iteration. On exit, the columns of the row-major
+ * d-by-d matrix q are approximate eigenvectors of the symmetric matrix c.
+ * Only the orthogonality of q is relied upon, and that is checked later.
+ */
+
+static void jacobi (double *c, double *q, arpra_uint d)
+{
+    arpra_uint sweep, p, r, i;
+    double off, theta, t, cs, sn, u, v;
+
+    for (p = 0; p < d; p++) {
+        for (r = 0; r < d; r++) {
+            q[p * d + r] = (p == r) ? 1.0 : 0.0;
+        }
+    }
+
+    for (sweep = 0; sweep < 50; sweep++) {
+        for (p = 0, off = 0.0; p < d; p++) {
+            for (r = p + 1; r < d; r++) {
+                off += c[p * d + r] * c[p * d + r];
+            }
+        }
+        if (off == 0.0) {
+            break;
+        }
+
+        for (p = 0; p < d; p++) {
+            for (r = p + 1; r < d; r++) {
+                if (c[p * d + r] == 0.0) {
+                    continue;
+                }
+
+                // Rotate to annihilate c[p][r].
+                theta = (c[r * d + r] - c[p * d + p]) / (2.0 * c[p * d + r]);
+                t = 1.0 / (fabs(theta) + sqrt(theta * theta + 1.0));
+                if (theta < 0.0) {
+                    t = -t;
+                }
+                cs = 1.0 / sqrt(t * t + 1.0);
+                sn = t * cs;
+                for (i = 0; i < d; i++) {
+                    u = c[i * d + p];
+                    v = c[i * d + r];
+                    c[i * d + p] = cs * u - sn * v;
+                    c[i * d + r] = sn * u + cs * v;
+                }
+                for (i = 0; i < d; i++) {
+                    u = c[p * d + i];
+                    v = c[r * d + i];
+                    c[p * d + i] = cs * u - sn * v;
+                    c[r * d + i] = sn * u + cs * v;
+                }
+                for (i = 0; i < d; i++) {
+                    u = q[i * d + p];
+                    v = q[i * d + r];
+                    q[i * d + p] = cs * u - sn * v;
+                    q[i * d + r] = sn * u + cs * v;
+                }
+            }
+        }
+    }
+}
+
+/*
+ * Enclose the condensed generators g (d rows, m columns, NULL for zero) in
+ * the parallelotope Q diag(r). Since Q is only approximately orthogonal,
+ * |Q^-1 g| <= |Q^T g| + eta ||g||, with eta = ||Q^T|| delta / (1 - delta)
+ * and delta = ||I - Q^T Q|| (infinity norms). Each r[j] is rounded so that
+ * Q[i][j] r[j] is exact at prec bits. Returns zero if Q is unusable.
+ */
+
+static int pca_enclose (mpfr_ptr r, double *q, mpfr_srcptr *g,
+                        arpra_uint d, arpra_uint m, arpra_prec prec)
+{
+    mpfr_t lo, hi, temp, delta, eta, gsum, row;
+    double *c, *v;
+    mpfr_exp_t exp, exp_max;
+    arpra_uint i, j, l, s;
+    int ok;
+
+    if (prec <= 53 + MPFR_PREC_MIN) {
+        return 0;
+    }
+
+    // Initialise vars.
+    mpfr_init2(lo, prec);
+    mpfr_init2(hi, prec);
+    mpfr_init2(temp, prec);
+    mpfr_init2(delta, prec);
+    mpfr_init2(eta, prec);
+    mpfr_init2(gsum, prec);
+    mpfr_init2(row, prec);
+    c = calloc(d * d, sizeof(double));
+    v = malloc(d * sizeof(double));
+
+    // Scaled second moments of the generators.
+    for (s = 0, exp_max = mpfr_get_emin(); s < m; s++) {
+        for (i = 0; i < d; i++) {
+            if ((g[i * m + s] != NULL) && !mpfr_zero_p(g[i * m + s])) {
+                exp = mpfr_get_exp(g[i * m + s]);
+                if (exp > exp_max) {
+                    exp_max = exp;
+                }
+            }
+        }
+    }
+    for (s = 0; s < m; s++) {
+        for (i = 0; i < d; i++) {
+            v[i] = 0.0;
+            if (g[i * m + s] != NULL) {
+                v[i] = mpfr_get_d_2exp(&exp, g[i * m + s], MPFR_RNDN);
+                v[i] = ldexp(v[i], (int) (exp - exp_max));
+            }
+        }
+        for (i = 0; i < d; i++) {
+            for (j = 0; j < d; j++) {
+                c[i * d + j] += v[i] * v[j];
+            }
+        }
+    }
+
+    // Principal axes.
+    jacobi(c, q, d);
+
+    // delta = ||I - Q^T Q||
+    mpfr_set_zero(delta, 1);
+    for (i = 0; i < d; i++) {
+        mpfr_set_zero(row, 1);
+        for (j = 0; j < d; j++) {
+            mpfr_set_si(lo, (i == j) ? -1 : 0, MPFR_RNDN);
+            mpfr_set(hi, lo, MPFR_RNDN);
+            for (l = 0; l < d; l++) {
+                mpfr_set_d(temp, q[l * d + i], MPFR_RNDN);
+                mpfr_mul_d(temp, temp, q[l * d + j], MPFR_RNDD);
+                mpfr_add(lo, lo, temp, MPFR_RNDD);
+                mpfr_set_d(temp, q[l * d + i], MPFR_RNDN);
+                mpfr_mul_d(temp, temp, q[l * d + j], MPFR_RNDU);
+                mpfr_add(hi, hi, temp, MPFR_RNDU);
+            }
+            mpfr_abs(lo, lo, MPFR_RNDU);
+            mpfr_abs(hi, hi, MPFR_RNDU);
+            mpfr_max(temp, lo, hi, MPFR_RNDU);
+            mpfr_add(row, row, temp, MPFR_RNDU);
+        }
+        mpfr_max(delta, delta, row, MPFR_RNDU);
+    }
+    ok = (mpfr_cmp_d(delta, 0.5) < 0);
+
+    if (ok) {
+        // eta = ||Q^T|| delta / (1 - delta)
+        mpfr_set_zero(eta, 1);
+        for (j = 0; j < d; j++) {
+            mpfr_set_zero(row, 1);
+            for (i = 0; i < d; i++) {
+                mpfr_set_d(temp, fabs(q[i * d + j]), MPFR_RNDN);
+                mpfr_add(row, row, temp, MPFR_RNDU);
+            }
+            mpfr_max(eta, eta, row, MPFR_RNDU);
+        }
+        mpfr_mul(eta, eta, delta, MPFR_RNDU);
+        mpfr_ui_sub(temp, 1, delta, MPFR_RNDD);
+        mpfr_div(eta, eta, temp, MPFR_RNDU);
+
+        // gsum = sum_s ||g_s||
+        mpfr_set_zero(gsum, 1);
+        for (s = 0; s < m; s++) {
+            mpfr_set_zero(row, 1);
+            for (i = 0; i < d; i++) {
+                if (g[i * m + s] != NULL) {
+                    mpfr_abs(temp, g[i * m + s], MPFR_RNDU);
+                    mpfr_max(row, row, temp, MPFR_RNDU);
+                }
+            }
+            mpfr_add(gsum, gsum, row, MPFR_RNDU);
+        }
+        mpfr_mul(gsum, gsum, eta, MPFR_RNDU);
+
+        // r_j = sum_s |(Q^T g_s)_j| + eta gsum
+        for (j = 0; j < d; j++) {
+            mpfr_set(&(r[j]), gsum, MPFR_RNDU);
+            for (s = 0; s < m; s++) {
+                mpfr_set_zero(lo, 1);
+                mpfr_set_zero(hi, 1);
+                for (i = 0; i < d; i++) {
+                    if (g[i * m + s] != NULL) {
+                        mpfr_mul_d(temp, g[i * m + s], q[i * d + j], MPFR_RNDD);
+                        mpfr_add(lo, lo, temp, MPFR_RNDD);
+                        mpfr_mul_d(temp, g[i * m + s], q[i * d + j], MPFR_RNDU);
+                        mpfr_add(hi, hi, temp, MPFR_RNDU);
+                    }
+                }
+                mpfr_abs(lo, lo, MPFR_RNDU);
+                mpfr_abs(hi, hi, MPFR_RNDU);
+                mpfr_max(temp, lo, hi, MPFR_RNDU);
+                mpfr_add(&(r[j]), &(r[j]), temp, MPFR_RNDU);
+            }
+            mpfr_prec_round(&(r[j]), (prec - 53), MPFR_RNDU);
+        }
+    }
+
+    // Clear vars.
+    mpfr_clear(lo);
+    mpfr_clear(hi);
+    mpfr_clear(temp);
+    mpfr_clear(delta);
+    mpfr_clear(eta);
+    mpfr_clear(gsum);
+    mpfr_clear(row);
+    free(c);
+    free(v);
+
+    return ok;
+}
+
+void arpra_reduce_vector (arpra_range *y, const arpra_range *x, arpra_uint n, arpra_uint k)
+{
+    mpfr_t error;
+    arpra_rnderr rnderr;
+    mpfr_ptr r, sum_x, *sum_x_ptr;
+    mpfr_srcptr *g;
+    double *q;
+    arpra_range *yy;
+    arpra_symbol *symbols, *shared;
+    arpra_uint *cond, **col;
+    reduce_key *keys;
+    arpra_reduce_method method;
+    arpra_symbol_class class;
+    arpra_prec prec_internal, prec_deviation;
+    arpra_uint i, j, i_y, i_x, m, m_keep, m_cond, n_sum;
+    double a, *key_max;
+
+    // Domain violations:
+    // reduce(NaN) = (NaN)
+    // reduce(Inf) = (Inf)
+
+    // Compute the ranges of dirty inputs.
+    for (i = 0; i < n; i++) {
+        arpra_helper_update_range(&(x[i]));
+    }
+
+    // Initialise vars.
+    prec_internal = arpra_get_internal_precision();
+    mpfr_init2(error, prec_internal);
+    yy = malloc(n * sizeof(arpra_range));
+    col = malloc(n * sizeof(arpra_uint *));
+
+    // Collect the symbols of all bounded ranges.
+    for (i = 0, m = 0; i < n; i++) {
+        if (arpra_bounded_p(&(x[i]))) {
+            m += x[i].nTerms;
+        }
+    }
+    symbols = malloc(m * sizeof(arpra_symbol));
+    for (i = 0, m = 0; i < n; i++) {
+        if (arpra_bounded_p(&(x[i]))) {
+            for (i_x = 0; i_x < x[i].nTerms; i_x++) {
+                symbols[m++] = x[i].symbols[i_x];
+            }
+        }
+    }
+    qsort(symbols, m, sizeof(arpra_symbol), &symbol_cmp);
+    for (i = 0, j = 0; i < m; i++) {
+        if ((j == 0) || (symbols[i] != symbols[j - 1])) {
+            symbols[j++] = symbols[i];
+        }
+    }
+    m = j;
+
+    // Find the column of each term, and the Girard key of each column.
+    keys = malloc(m * sizeof(reduce_key));
+    key_max = malloc(m * sizeof(double));
+    for (j = 0, m_keep = 0; j < m; j++) {
+        keys[j].keep = !arpra_helper_reducible_p(symbols[j]);
+        m_keep += keys[j].keep;
+        keys[j].key = 0.0;
+        keys[j].col = j;
+        key_max[j] = 0.0;
+    }
+    for (i = 0; i < n; i++) {
+        col[i] = NULL;
+        if (arpra_bounded_p(&(x[i]))) {
+            col[i] = malloc(x[i].nTerms * sizeof(arpra_uint));
+            for (i_x = 0, j = 0; i_x < x[i].nTerms; i_x++) {
+                while (symbols[j] != x[i].symbols[i_x]) {
+                    j++;
+                }
+                col[i][i_x] = j;
+                a = fabs(mpfr_get_d(&(x[i].deviations[i_x]), MPFR_RNDN));
+                keys[j].key += a;
+                if (a > key_max[j]) {
+                    key_max[j] = a;
+                }
+            }
+        }
+    }
+    for (j = 0; j < m; j++) {
+        keys[j].key -= key_max[j];
+    }
+
+    // Condense all but the k columns with the largest keys, and protected columns.
+    cond = calloc(m + 1, sizeof(arpra_uint));
+    m_cond = 0;
+    class = ARPRA_SYMBOL_ROUNDING;
+    if (m > (k + m_keep)) {
+        qsort(keys, m, sizeof(reduce_key), &key_cmp);
+        for (j = 0; j < m - k - m_keep; j++) {
+            cond[keys[j].col] = 1;
+        }
+        for (j = 0; j < m; j++) {
+            if (cond[j]) {
+                cond[j] = ++m_cond;
+                if (ARPRA_SYMBOL_CLASS(symbols[j]) > class) {
+                    class = ARPRA_SYMBOL_CLASS(symbols[j]);
+                }
+            }
+        }
+    }
+
+    // Enclose condensed columns in a shared parallelotope, if possible.
+    method = (m_cond > 0) ? reduce_method : ARPRA_REDUCE_BOX;
+    r = NULL;
+    q = NULL;
+    shared = NULL;
+    if (method == ARPRA_REDUCE_PCA) {
+        g = calloc(n * m_cond, sizeof(mpfr_srcptr));
+        for (i = 0; i < n; i++) {
+            if (col[i] != NULL) {
+                for (i_x = 0; i_x < x[i].nTerms; i_x++) {
+                    if (cond[col[i][i_x]]) {
+                        g[i * m_cond + cond[col[i][i_x]] - 1] = &(x[i].deviations[i_x]);
+                    }
+                }
+            }
+        }
+        r = malloc(n * sizeof(mpfr_t));
+        q = malloc(n * n * sizeof(double));
+        shared = malloc(n * sizeof(arpra_symbol));
+        for (j = 0; j < n; j++) {
+            mpfr_init2(&(r[j]), prec_internal);
+        }
+        if (pca_enclose(r, q, g, n, m_cond, prec_internal)) {
+            for (j = 0; j < n; j++) {
+                if (!mpfr_zero_p(&(r[j]))) {
+                    shared[j] = arpra_helper_next_symbol(class);
+                }
+            }
+        }
+        else {
+            method = ARPRA_REDUCE_BOX;
+        }
+        free(g);
+    }
+
+    sum_x = malloc((m + 1) * sizeof(mpfr_t));
+    sum_x_ptr = malloc((m + 1) * sizeof(mpfr_ptr));
+
+    for (i = 0; i < n; i++) {
+        arpra_init2(&(yy[i]), y[i].precision);
+        yy[i].deviation_precision = y[i].deviation_precision;
+        yy[i].internal_precision = y[i].internal_precision;
+        yy[i].range_method = y[i].range_method;
+        yy[i].wide_ops = x[i].wide_ops;
+        prec_deviation = arpra_helper_deviation_precision(&(y[i]));
+
+        // Handle domain violations.
+        if (arpra_nan_p(&(x[i]))) {
+            arpra_set_nan(&(yy[i]));
+            continue;
+        }
+        if (arpra_inf_p(&(x[i]))) {
+            arpra_set_inf(&(yy[i]));
+            continue;
+        }
+
+        mpfr_set_zero(error, 1);
+        mpfr_set_zero(&(yy[i].radius), 1);
+        arpra_helper_rnderr_init(&rnderr);
+
+        // y[0] = x[0]
+        ARPRA_MPFR_RNDERR_SET(error, MPFR_RNDN, &(yy[i].centre), &(x[i].centre));
+
+        // Allocate memory for deviation terms.
+        arpra_helper_alloc_terms(&(yy[i]), x[i].nTerms + n + 1);
+
+        for (i_y = 0, i_x = 0, n_sum = 0; i_x < x[i].nTerms; i_x++) {
+            if (!cond[col[i][i_x]]) {
+                mpfr_init2(&(yy[i].deviations[i_y]), prec_deviation);
+
+                // y[i] = x[i]
+                yy[i].symbols[i_y] = x[i].symbols[i_x];
+                ARPRA_MPFR_RNDACC_SET(&rnderr, MPFR_RNDN, &(yy[i].deviations[i_y]), &(x[i].deviations[i_x]));
+                ARPRA_RADIUS_ADD(&(yy[i].radius), &(yy[i].deviations[i_y]));
+
+                i_y++;
+            }
+            else if (method == ARPRA_REDUCE_BOX) {
+                // This term will be merged.
+                sum_x[n_sum] = x[i].deviations[i_x];
+                sum_x[n_sum]._mpfr_sign = 1;
+                sum_x_ptr[n_sum] = &(sum_x[n_sum]);
+                n_sum++;
+            }
+        }
+
+        // Shared terms: y[j] = Q[i][j] r[j], which is exact.
+        if (method == ARPRA_REDUCE_PCA) {
+            for (j = 0; j < n; j++) {
+                if (!mpfr_zero_p(&(r[j])) && (q[i * n + j] != 0.0)) {
+                    mpfr_init2(&(yy[i].deviations[i_y]), prec_deviation);
+                    yy[i].symbols[i_y] = shared[j];
+                    ARPRA_MPFR_RNDACC(&rnderr, MPFR_RNDN, mpfr_mul_d, &(yy[i].deviations[i_y]), &(r[j]), q[i * n + j]);
+                    ARPRA_RADIUS_ADD(&(yy[i].radius), &(yy[i].deviations[i_y]));
+                    i_y++;
+                }
+            }
+        }
+
+        // Merge deviation terms.
+        arpra_helper_rnderr_get(error, &rnderr);
+        sum_x_ptr[n_sum] = error;
+        mpfr_sum(error, sum_x_ptr, (n_sum + 1), MPFR_RNDU);
+
+        // Store new deviation term.
+        mpfr_init2(&(yy[i].deviations[i_y]), prec_internal);
+        yy[i].symbols[i_y] = arpra_helper_next_symbol(class);
+        mpfr_set(&(yy[i].deviations[i_y]), error, MPFR_RNDU);
+        ARPRA_RADIUS_ADD(&(yy[i].radius), &(yy[i].deviations[i_y]));
+        yy[i].nTerms = i_y + 1;
+
+        // Compute true_range.
+        arpra_helper_compute_range(&(yy[i]));
+
+        // Mix with IA range, and trim error term.
+        arpra_helper_mix_trim(&(yy[i]), &(x[i].true_range));
+
+        // Check for NaN and Inf.
+        arpra_helper_check_result(&(yy[i]));
+    }
+
+    // Clear vars, and set y.
+    for (i = 0; i < n; i++) {
+        arpra_clear(&(y[i]));
+        y[i] = yy[i];
+        free(col[i]);
+    }
+    if (r != NULL) {
+        for (j = 0; j < n; j++) {
+            mpfr_clear(&(r[j]));
+        }
+    }
+    mpfr_clear(error);
+    free(yy);
+    free(col);
+    free(symbols);
+    free(keys);
+    free(key_max);
+    free(cond);
+    free(r);
+    free(q);
+    free(shared);
+    free(sum_x);
+    free(sum_x_ptr);
+}
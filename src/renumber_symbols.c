@@ -0,0 +1,85 @@
+/*
+ * renumber_symbols.c -- Compact the noise symbols of live ranges.
+ *
+ * Copyright 2016-2020 James Paul Turner.
+ *
+ * This file is part of the Arpra library.
+ *
+ * The Arpra library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Arpra library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with the Arpra library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "arpra-impl.h"
+
+static int symbol_cmp (const void *a, const void *b)
+{
+    arpra_symbol sa = *((const arpra_symbol *) a);
+    arpra_symbol sb = *((const arpra_symbol *) b);
+
+    return (sa > sb) - (sa < sb);
+}
+
+/*
+ * Renumber the symbols of the n ranges pointed to by x. Symbols store their
+ * class in the low ARPRA_SYMBOL_CLASS_BITS bits, and a sequence number above
+ * them. The m distinct symbols among the ranges are ranked 0 to m - 1 in
+ * their original order, and each is replaced by (rank << CLASS_BITS) | class,
+ * so their order and classes are kept. The symbol counter then restarts at
+ * m << CLASS_BITS. Any range that is not in x must not be used with these
+ * ranges again, since its symbols may now clash with theirs.
+ */
+
+void arpra_renumber_symbols (arpra_range **x, arpra_uint n)
+{
+    arpra_symbol *symbols, *renumbered, *symbol;
+    arpra_uint i, i_x, m, j;
+
+    // Collect all symbols in order.
+    for (i = 0, m = 0; i < n; i++) {
+        m += x[i]->nTerms;
+    }
+    symbols = malloc(m * sizeof(arpra_symbol));
+    renumbered = malloc(m * sizeof(arpra_symbol));
+    for (i = 0, m = 0; i < n; i++) {
+        for (i_x = 0; i_x < x[i]->nTerms; i_x++) {
+            symbols[m++] = x[i]->symbols[i_x];
+        }
+    }
+    qsort(symbols, m, sizeof(arpra_symbol), &symbol_cmp);
+    for (i = 0, j = 0; i < m; i++) {
+        if ((j == 0) || (symbols[i] != symbols[j - 1])) {
+            symbols[j++] = symbols[i];
+        }
+    }
+
+    // Find the rank of every term's symbol before replacing any, since a
+    // range may be listed more than once.
+    for (i = 0, m = 0; i < n; i++) {
+        for (i_x = 0; i_x < x[i]->nTerms; i_x++) {
+            symbol = bsearch(&(x[i]->symbols[i_x]), symbols, j, sizeof(arpra_symbol), &symbol_cmp);
+            renumbered[m++] = ((arpra_symbol) (symbol - symbols) << ARPRA_SYMBOL_CLASS_BITS)
+                | ARPRA_SYMBOL_CLASS(*symbol);
+        }
+    }
+    for (i = 0, m = 0; i < n; i++) {
+        arpra_helper_own_terms(x[i]);
+        for (i_x = 0; i_x < x[i]->nTerms; i_x++) {
+            x[i]->symbols[i_x] = renumbered[m++];
+        }
+    }
+    arpra_helper_set_symbol_count((arpra_uint) j << ARPRA_SYMBOL_CLASS_BITS);
+
+    free(symbols);
+    free(renumbered);
+}
@@ -26,6 +26,7 @@ void arpra_set (arpra_range *y, const arpra_range *x1)
     mpfi_t ia_range;
     mpfi_t alpha, gamma;
     mpfr_t delta;
+    arpra_prec prec_range;
 
     // Handle y = x1 case.
     if (y == x1) return;
@@ -44,6 +45,30 @@ void arpra_set (arpra_range *y, const arpra_range *x1)
         return;
     }
 
+    // Interval method.
+    if (arpra_helper_range_method(y) == ARPRA_IA) {
+        arpra_helper_ia_1(y, mpfi_set, x1);
+        return;
+    }
+
+    // Compute the range of x1, if it is dirty.
+    arpra_helper_update_range(x1);
+
+    // Share x1's terms if y would give them the same precisions.
+    prec_range = arpra_helper_range_precision(y);
+    if ((y->precision == x1->precision)
+            && (mpfr_get_prec(&(x1->centre)) == prec_range)
+            && (arpra_helper_deviation_precision(y) == arpra_helper_deviation_precision(x1))) {
+        mpfr_set_prec(&(y->centre), prec_range);
+        mpfr_set_prec(&(y->radius), prec_range);
+        mpfr_set(&(y->centre), &(x1->centre), MPFR_RNDN);
+        mpfr_set(&(y->radius), &(x1->radius), MPFR_RNDN);
+        mpfi_set(&(y->true_range), &(x1->true_range));
+        arpra_helper_share_terms(y, x1);
+        y->dirty = ARPRA_RANGE_CLEAN;
+        return;
+    }
+
     // Initialise vars.
     mpfi_init2(ia_range, y->precision);
     mpfi_init2(alpha, 2);
@@ -59,6 +84,11 @@ void arpra_set (arpra_range *y, const arpra_range *x1)
     // y = x1
     arpra_helper_affine_1(y, x1, alpha, gamma, delta);
 
+    // Round to the internal precision of y, as arpra_set_precision does.
+    if (mpfr_get_prec(&(y->centre)) > prec_range) {
+        arpra_helper_affine_1(y, y, alpha, gamma, delta);
+    }
+
     // Compute true_range.
     arpra_helper_compute_range(y);
 
@@ -21,7 +21,7 @@
 
 #include "arpra-impl.h"
 
-void arpra_set_mpfi (arpra_range *y, mpfi_srcptr x1)
+void arpra_helper_set_mpfi (arpra_range *y, mpfi_srcptr x1, arpra_symbol_class class)
 {
     mpfr_t temp1, temp2;
     arpra_prec prec_internal;
@@ -55,8 +55,7 @@ void arpra_set_mpfi (arpra_range *y, mpfi_srcptr x1)
     mpfi_mid(&(y->centre), &(y->true_range));
 
     // Allocate memory for deviation terms.
-    y->symbols = malloc(sizeof(arpra_uint));
-    y->deviations = malloc(sizeof(mpfr_t));
+    arpra_helper_alloc_terms(y, 1);
 
     // rad(y) = max{(y[0] - x1[lo]), (x1[hi] - y[0])}
     mpfr_sub(temp1, &(y->centre), &(y->true_range.left), MPFR_RNDU);
@@ -64,10 +63,12 @@ void arpra_set_mpfi (arpra_range *y, mpfi_srcptr x1)
     mpfr_max(&(y->radius), temp1, temp2, MPFR_RNDU);
 
     // Store new deviation term.
-    y->symbols[0] = arpra_helper_next_symbol();
+    y->symbols[0] = arpra_helper_next_symbol(class);
     mpfr_init2(&(y->deviations[0]), prec_internal);
     mpfr_set(&(y->deviations[0]), &(y->radius), MPFR_RNDU);
     y->nTerms = 1;
+    y->wide_ops = 0;
+    y->dirty = ARPRA_RANGE_CLEAN;
 
     // Check for NaN and Inf.
     arpra_helper_check_result(y);
@@ -76,3 +77,8 @@ void arpra_set_mpfi (arpra_range *y, mpfi_srcptr x1)
     mpfr_clear(temp1);
     mpfr_clear(temp2);
 }
+
+void arpra_set_mpfi (arpra_range *y, mpfi_srcptr x1)
+{
+    arpra_helper_set_mpfi(y, x1, arpra_get_symbol_class());
+}
@@ -34,6 +34,7 @@ void arpra_set_nan (arpra_range *y)
     // Set true_range.
     mpfr_set_nan(&(y->true_range.left));
     mpfr_set_nan(&(y->true_range.right));
+    y->dirty = ARPRA_RANGE_CLEAN;
 }
 
 void arpra_set_inf (arpra_range *y)
@@ -50,11 +51,10 @@ void arpra_set_inf (arpra_range *y)
     mpfr_set_zero(&(y->centre), 1);
 
     // Allocate memory for deviation terms.
-    y->symbols = malloc(sizeof(arpra_uint));
-    y->deviations = malloc(sizeof(mpfr_t));
+    arpra_helper_alloc_terms(y, 1);
 
     // Store new deviation term.
-    y->symbols[0] = arpra_helper_next_symbol();
+    y->symbols[0] = arpra_helper_next_symbol(ARPRA_SYMBOL_ROUNDING);
     mpfr_init2(&(y->deviations[0]), prec_internal);
     mpfr_set_inf(&(y->deviations[0]), 1);
     mpfr_set_inf(&(y->radius), 1);
@@ -63,6 +63,7 @@ void arpra_set_inf (arpra_range *y)
     // Set true_range.
     mpfr_set_inf(&(y->true_range.left), -1);
     mpfr_set_inf(&(y->true_range.right), 1);
+    y->dirty = ARPRA_RANGE_CLEAN;
 }
 
 void arpra_set_zero (arpra_range *y)
@@ -79,11 +80,10 @@ void arpra_set_zero (arpra_range *y)
     mpfr_set_zero(&(y->centre), 1);
 
     // Allocate memory for deviation terms.
-    y->symbols = malloc(sizeof(arpra_uint));
-    y->deviations = malloc(sizeof(mpfr_t));
+    arpra_helper_alloc_terms(y, 1);
 
     // Store new deviation term.
-    y->symbols[0] = arpra_helper_next_symbol();
+    y->symbols[0] = arpra_helper_next_symbol(ARPRA_SYMBOL_ROUNDING);
     mpfr_init2(&(y->deviations[0]), prec_internal);
     mpfr_set_zero(&(y->deviations[0]), 1);
     mpfr_set_zero(&(y->radius), 1);
@@ -92,4 +92,5 @@ void arpra_set_zero (arpra_range *y)
     // Set true_range.
     mpfr_set_zero(&(y->true_range.left), -1);
     mpfr_set_zero(&(y->true_range.right), 1);
+    y->dirty = ARPRA_RANGE_CLEAN;
 }
@@ -21,66 +21,72 @@
 
 #include "arpra-impl.h"
 
-void arpra_sum (arpra_range *y, arpra_range *x, arpra_uint n)
+static void ia_sum (mpfi_ptr y, const arpra_range *x, arpra_uint n)
 {
-    mpfr_t temp1, temp2, error;
-    mpfr_ptr *summands;
-    arpra_range yy;
-    arpra_prec prec_internal;
-    arpra_uint i, n_sum;
-    arpra_uint i_y, *i_x;
-    arpra_uint symbol;
-    arpra_int xHasNext;
+    arpra_uint i;
 
-    // Handle n <= 2 case.
-    if (n <= 2) {
-        if (n == 2) {
-            arpra_add(y, &x[0], &x[1]);
-        }
-        else if (n == 1) {
-            arpra_set(y, &x[0]);
-        }
-        else {
-            arpra_set_nan(y);
-        }
-        return;
+    mpfi_set(y, &(x[0].true_range));
+    for (i = 1; i < n; i++) {
+        mpfi_add(y, y, &(x[i].true_range));
     }
+}
 
-    // Domain violations:
-    // (NaN) + ... + (NaN) = (NaN)
-    // (NaN) + ... + (R)   = (NaN)
-    // (Inf) + ... + (Inf) = (NaN)
-    // (Inf) + ... + (R)   = (Inf)
+/*
+ * Min-heap of the inputs with terms left, keyed on the symbol of their next
+ * term. The terms of each input are sorted by symbol, so merging them with
+ * the heap takes O(log n) steps per input term.
+ */
 
-    // Handle domain violations.
-    for (i = 0; i < n; i++) {
-        if (arpra_nan_p(&x[i])) {
-            arpra_set_nan(y);
-            return;
+static inline arpra_symbol heap_key (const arpra_range *x, const arpra_uint *i_x, arpra_uint i)
+{
+    return x[i].symbols[i_x[i]];
+}
+
+static void heap_sift_down (arpra_uint *heap, arpra_uint n_heap, arpra_uint k,
+                            const arpra_range *x, const arpra_uint *i_x)
+{
+    arpra_uint top, child;
+    arpra_symbol key;
+
+    top = heap[k];
+    key = heap_key(x, i_x, top);
+    while ((child = (2 * k) + 1) < n_heap) {
+        if ((child + 1 < n_heap)
+            && (heap_key(x, i_x, heap[child + 1]) < heap_key(x, i_x, heap[child]))) {
+            child++;
         }
-    }
-    for (i = 0; i < n; i++) {
-        if (arpra_inf_p(&x[i])) {
-            for (++i; i < n; i++) {
-                if (arpra_inf_p(&x[i])) {
-                    arpra_set_nan(y);
-                    return;
-                }
-            }
-            arpra_set_inf(y);
-            return;
+        if (heap_key(x, i_x, heap[child]) >= key) {
+            break;
         }
+        heap[k] = heap[child];
+        k = child;
     }
+    heap[k] = top;
+}
+
+/*
+ * Merge the terms of x[0] ... x[n-1] into yy, which has been initialised but
+ * has no terms, and sum their centres and the radius of the merged terms.
+ * Room is left for one more term, and rounding errors are added to error.
+ * The inputs have already been checked for NaN and Inf.
+ */
+
+static void sum_terms (arpra_range *yy, arpra_range *x, arpra_uint n,
+                       arpra_prec prec_deviation, mpfr_ptr error)
+{
+    arpra_rnderr rnderr;
+    arpra_sumabs radius;
+    mpfr_ptr *summands;
+    arpra_uint i, n_sum, n_heap, n_terms;
+    arpra_uint i_y, *i_x, *heap;
+    arpra_symbol symbol;
 
     // Initialise vars.
-    prec_internal = arpra_get_internal_precision();
-    mpfr_init2(temp1, prec_internal + 8);
-    mpfr_init2(temp2, prec_internal + 8);
-    mpfr_init2(error, prec_internal);
-    arpra_init2(&yy, y->precision);
     summands = malloc(n * sizeof(mpfr_ptr));
     i_x = malloc(n * sizeof(arpra_uint));
-    mpfr_set_zero(error, 1);
+    heap = malloc(n * sizeof(arpra_uint));
+    arpra_helper_rnderr_init(&rnderr);
+    arpra_helper_sumabs_init(&radius);
 
     // Zero term indexes, and fill summand array with centre values.
     i_y = 0;
@@ -90,79 +96,166 @@ void arpra_sum (arpra_range *y, arpra_range *x, arpra_uint n)
     }
 
     // y[0] = x1[0] + ... + xn[0]
-    ARPRA_MPFR_RNDERR_SUM(error, MPFR_RNDN, &(yy.centre), summands, n);
+    ARPRA_MPFR_RNDERR_SUM(error, MPFR_RNDN, &(yy->centre), summands, n);
 
-    // Allocate memory for deviation terms.
-    yy.nTerms = 1;
+    // Allocate memory for deviation terms, and heap the inputs with terms.
+    n_terms = 0;
+    n_heap = 0;
     for (i = 0; i < n; i++) {
-        yy.nTerms += x[i].nTerms;
+        n_terms += x[i].nTerms;
+        if (x[i].wide_ops > yy->wide_ops) {
+            yy->wide_ops = x[i].wide_ops;
+        }
+        if (x[i].nTerms > 0) {
+            heap[n_heap++] = i;
+        }
+    }
+    if (n_terms > 0) {
+        arpra_helper_alloc_terms(yy, n_terms + 1);
+    }
+    for (i = n_heap / 2; i-- > 0;) {
+        heap_sift_down(heap, n_heap, i, x, i_x);
     }
-    yy.symbols = malloc(yy.nTerms * sizeof(arpra_uint));
-    yy.deviations = malloc(yy.nTerms * sizeof(mpfr_t));
 
     // For all unique symbols in x.
-    xHasNext = yy.nTerms > 1;
-    while (xHasNext) {
-        mpfr_init2(&(yy.deviations[i_y]), prec_internal);
-        xHasNext = 0;
-        symbol = -1;
-
-        // Find and set the next lowest symbol in y.
-        for (i = 0; i < n; i++) {
-            if (i_x[i] < x[i].nTerms) {
-                if (x[i].symbols[i_x[i]] < symbol) {
-                    symbol = x[i].symbols[i_x[i]];
-                }
-            }
-        }
-        yy.symbols[i_y] = symbol;
+    while (n_heap > 0) {
+        mpfr_init2(&(yy->deviations[i_y]), prec_deviation);
+        symbol = heap_key(x, i_x, heap[0]);
+        yy->symbols[i_y] = symbol;
 
-        // For all x with the next symbol:
-        for (n_sum = 0, i = 0; i < n; i++) {
-            if (x[i].symbols[i_x[i]] == symbol) {
-                // Get next deviation pointer of x[i].
-                summands[n_sum++] = &(x[i].deviations[i_x[i]]);
-                xHasNext += ++i_x[i] < x[i].nTerms;
+        // For all x with the next symbol, get the next deviation pointer.
+        n_sum = 0;
+        while ((n_heap > 0) && (heap_key(x, i_x, heap[0]) == symbol)) {
+            i = heap[0];
+            summands[n_sum++] = &(x[i].deviations[i_x[i]]);
+            if (++i_x[i] == x[i].nTerms) {
+                heap[0] = heap[--n_heap];
+            }
+            if (n_heap > 0) {
+                heap_sift_down(heap, n_heap, 0, x, i_x);
             }
         }
 
         // y[i] = x1[i] + ... + xn[i]
-        ARPRA_MPFR_RNDERR_SUM(error, MPFR_RNDN, &(yy.deviations[i_y]), summands, n_sum);
+        ARPRA_MPFR_RNDACC_SUM(&rnderr, MPFR_RNDN, &(yy->deviations[i_y]), summands, n_sum);
+        arpra_helper_sumabs_add(&radius, &(yy->deviations[i_y]));
         i_y++;
     }
+    yy->nTerms = i_y;
+    arpra_helper_rnderr_get(error, &rnderr);
+    arpra_helper_sumabs_get(&(yy->radius), &radius);
+
+    // Clear vars.
+    free(summands);
+    free(i_x);
+    free(heap);
+}
+
+/*
+ * Store error, plus delta unless it is NULL, as the new error term of yy,
+ * the merged sum of x[0] ... x[n-1]. Then compute its range, and set y to
+ * yy. The error variable is moved into yy.
+ */
+
+static void sum_store (arpra_range *y, arpra_range *yy, arpra_range *x, arpra_uint n,
+                       mpfr_ptr error, mpfr_srcptr delta)
+{
+    mpfi_t ia_range;
+    arpra_uint i_y;
 
     // Store new deviation term.
-    yy.symbols[i_y] = arpra_helper_next_symbol();
-    yy.deviations[i_y] = *error;
-    yy.nTerms = i_y + 1;
+    i_y = yy->nTerms;
+    if (i_y == 0) {
+        arpra_helper_alloc_terms(yy, 1);
+    }
+    if (delta != NULL) {
+        mpfr_add(error, error, delta, MPFR_RNDU);
+    }
+    yy->symbols[i_y] = arpra_helper_next_symbol(((delta == NULL) || mpfr_zero_p(delta))
+                                                ? ARPRA_SYMBOL_ROUNDING : ARPRA_SYMBOL_APPROXIMATION);
+    yy->deviations[i_y] = *error;
+    mpfr_add(&(yy->radius), &(yy->radius), &(yy->deviations[i_y]), MPFR_RNDU);
+    yy->nTerms = i_y + 1;
 
-    // Compute true_range.
-    arpra_helper_compute_range(&yy);
+    // Defer true_range until it is needed, with lazy ranges.
+    if (arpra_get_lazy_range()) {
+        mpfi_init2(ia_range, y->precision);
+        ia_sum(ia_range, x, n);
+        if (delta != NULL) {
+            mpfi_increase(ia_range, delta);
+        }
+        yy->dirty = ARPRA_RANGE_DIRTY;
+        arpra_helper_defer_range(yy, ia_range);
+        mpfi_clear(ia_range);
+    }
+    else {
+        // Compute true_range.
+        arpra_helper_compute_range(yy);
 
-    // Check for NaN and Inf.
-    arpra_helper_check_result(&yy);
+        // Check for NaN and Inf.
+        arpra_helper_check_result(yy);
+    }
 
-    // Clear vars, and set y.
-    mpfr_clear(temp1);
-    mpfr_clear(temp2);
+    // Set y.
     arpra_clear(y);
-    *y = yy;
-    free(summands);
-    free(i_x);
+    *y = *yy;
 }
 
 /*
- * Error bound for recursive summation (any ordering, any n).
- *
- * Rump, S. Error estimation of floating-point summation and dot product.
- * BIT Numer Math (2012) 52:201-220.
+ * Sum x[0] ... x[n-1] into y, and add delta to the new error term, unless
+ * delta is NULL. The inputs have already been checked for NaN and Inf.
  */
 
-void arpra_sum_recursive (arpra_range *y, arpra_range *x, arpra_uint n)
+static void sum_n (arpra_range *y, arpra_range *x, arpra_uint n, mpfr_srcptr delta)
+{
+    mpfi_t ia_range;
+    mpfr_t error;
+    arpra_range yy;
+    arpra_prec prec_internal, prec_op, prec_prev;
+    arpra_uint i;
+
+    // Interval method.
+    if (arpra_helper_range_method(y) == ARPRA_IA) {
+        mpfi_init2(ia_range, y->precision);
+        ia_sum(ia_range, x, n);
+        if (delta != NULL) {
+            mpfi_increase(ia_range, delta);
+        }
+        arpra_helper_set_mpfi(y, ia_range, ARPRA_SYMBOL_APPROXIMATION);
+        mpfi_clear(ia_range);
+        return;
+    }
+
+    // Choose the working precision.
+    prec_op = 0;
+    for (i = 0; i < n; i++) {
+        prec_op = arpra_helper_op_precision(prec_op, y, &x[i]);
+    }
+    prec_prev = arpra_helper_push_precision(prec_op);
+
+    // Initialise vars.
+    prec_internal = arpra_get_internal_precision();
+    mpfr_init2(error, prec_internal);
+    mpfr_set_zero(error, 1);
+    arpra_init2(&yy, y->precision);
+    yy.deviation_precision = y->deviation_precision;
+    yy.internal_precision = y->internal_precision;
+    yy.range_method = y->range_method;
+
+    // y = x1 + ... + xn
+    sum_terms(&yy, x, n, arpra_helper_deviation_precision(y), error);
+    sum_store(y, &yy, x, n, error, delta);
+
+    arpra_helper_pop_precision(prec_prev);
+}
+
+/*
+ * Handle the n <= 2 case, and domain violations. Returns nonzero if y has
+ * been set.
+ */
+
+static int sum_special (arpra_range *y, arpra_range *x, arpra_uint n)
 {
-    mpfr_t temp1, temp2;
-    mpfr_ptr sum_x, *sum_x_ptr;
-    arpra_prec prec_internal;
     arpra_uint i;
 
     // Handle n <= 2 case.
@@ -176,7 +269,7 @@ void arpra_sum_recursive (arpra_range *y, arpra_range *x, arpra_uint n)
         else {
             arpra_set_nan(y);
         }
-        return;
+        return 1;
     }
 
     // Domain violations:
@@ -189,7 +282,7 @@ void arpra_sum_recursive (arpra_range *y, arpra_range *x, arpra_uint n)
     for (i = 0; i < n; i++) {
         if (arpra_nan_p(&x[i])) {
             arpra_set_nan(y);
-            return;
+            return 1;
         }
     }
     for (i = 0; i < n; i++) {
@@ -197,12 +290,188 @@ void arpra_sum_recursive (arpra_range *y, arpra_range *x, arpra_uint n)
             for (++i; i < n; i++) {
                 if (arpra_inf_p(&x[i])) {
                     arpra_set_nan(y);
-                    return;
+                    return 1;
                 }
             }
             arpra_set_inf(y);
-            return;
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+void arpra_sum (arpra_range *y, arpra_range *x, arpra_uint n)
+{
+    if (sum_special(y, x, n)) {
+        return;
+    }
+
+    // y = x1 + ... + xn
+    sum_n(y, x, n, NULL);
+}
+
+/*
+ * arpra_sum_parallel splits x into one partition per thread, with about the
+ * same number of terms in each, and merges the partitions in parallel. The
+ * partial sums are then merged in pairs, level by level, until one is left.
+ * Rounding errors of every merge are gathered into the single new error term,
+ * so the result has the same terms as arpra_sum, and an error term that may
+ * be slightly larger.
+ */
+
+typedef struct sum_job_struct
+{
+    arpra_range *x;
+    arpra_range *y;
+    arpra_uint *first;
+    mpfr_ptr error;
+    arpra_uint n;
+    arpra_prec prec_deviation;
+} sum_job;
+
+static void sum_part_task (void *arg, arpra_uint i)
+{
+    sum_job *job;
+
+    // y[i] = x[first[i]] + ... + x[first[i + 1] - 1]
+    job = (sum_job *) arg;
+    sum_terms(&(job->y[i]), &(job->x[job->first[i]]), job->first[i + 1] - job->first[i],
+              job->prec_deviation, &(job->error[i]));
+}
+
+static void sum_pair_task (void *arg, arpra_uint i)
+{
+    sum_job *job;
+
+    // y[i] = x[2i] + x[2i + 1], or x[2i] if it is the last one.
+    job = (sum_job *) arg;
+    if ((2 * i) + 1 < job->n) {
+        sum_terms(&(job->y[i]), &(job->x[2 * i]), 2,
+                  job->prec_deviation, &(job->error[i]));
+    }
+    else {
+        arpra_swap(&(job->y[i]), &(job->x[2 * i]));
+    }
+}
+
+void arpra_sum_parallel (arpra_range *y, arpra_range *x, arpra_uint n)
+{
+    arpra_range *part, *next, *temp;
+    arpra_prec prec_internal, prec_op, prec_prev;
+    arpra_uint i, n_part, n_next, n_error, terms, total;
+    sum_job job;
+
+    if (sum_special(y, x, n)) {
+        return;
+    }
+
+    // Use the serial sum with one thread, too few inputs to split, or IA.
+    n_part = arpra_get_threads();
+    if (n_part > (n / 2)) {
+        n_part = n / 2;
+    }
+    if ((n_part <= 1) || (arpra_helper_range_method(y) == ARPRA_IA)) {
+        sum_n(y, x, n, NULL);
+        return;
+    }
+
+    // Choose the working precision.
+    prec_op = 0;
+    for (i = 0; i < n; i++) {
+        prec_op = arpra_helper_op_precision(prec_op, y, &x[i]);
+    }
+    prec_prev = arpra_helper_push_precision(prec_op);
+
+    // Split x into partitions with about the same number of terms.
+    job.first = malloc((n_part + 1) * sizeof(arpra_uint));
+    for (i = 0, total = 0; i < n; i++) {
+        total += x[i].nTerms + 1;
+    }
+    job.first[0] = 0;
+    for (i = 0, n_next = 1, terms = 0; (i < n) && (n_next < n_part); i++) {
+        terms += x[i].nTerms + 1;
+        if (((terms * n_part) >= (n_next * total)) && ((i + 1) < n)) {
+            job.first[n_next++] = i + 1;
+        }
+    }
+    n_part = n_next;
+    n_error = n_part;
+    job.first[n_part] = n;
+
+    // Initialise vars.
+    prec_internal = arpra_get_internal_precision();
+    part = malloc(n_part * sizeof(arpra_range));
+    next = malloc(n_part * sizeof(arpra_range));
+    job.error = malloc(n_part * sizeof(mpfr_t));
+    job.prec_deviation = arpra_helper_deviation_precision(y);
+    for (i = 0; i < n_part; i++) {
+        arpra_init2(&(part[i]), y->precision);
+        mpfr_init2(&(job.error[i]), prec_internal);
+        mpfr_set_zero(&(job.error[i]), 1);
+    }
+
+    // Merge each partition.
+    job.x = x;
+    job.y = part;
+    job.n = n;
+    arpra_helper_parallel_for(&sum_part_task, &job, n_part, 0, NULL, 0, NULL);
+
+    // Merge partial sums in pairs.
+    while (n_part > 1) {
+        n_next = (n_part + 1) / 2;
+        for (i = 0; i < n_next; i++) {
+            arpra_init2(&(next[i]), y->precision);
+        }
+        job.x = part;
+        job.y = next;
+        job.n = n_part;
+        arpra_helper_parallel_for(&sum_pair_task, &job, n_next, 0, NULL, 0, NULL);
+        for (i = 0; i < n_part; i++) {
+            arpra_clear(&(part[i]));
         }
+        temp = part;
+        part = next;
+        next = temp;
+        n_part = n_next;
+    }
+
+    // Gather rounding errors.
+    for (i = 1; i < n_error; i++) {
+        mpfr_add(&(job.error[0]), &(job.error[0]), &(job.error[i]), MPFR_RNDU);
+        mpfr_clear(&(job.error[i]));
+    }
+
+    // y = x1 + ... + xn
+    part[0].deviation_precision = y->deviation_precision;
+    part[0].internal_precision = y->internal_precision;
+    part[0].range_method = y->range_method;
+    sum_store(y, &(part[0]), x, n, &(job.error[0]), NULL);
+
+    // Clear vars.
+    free(part);
+    free(next);
+    free(job.first);
+    free(job.error);
+    arpra_helper_pop_precision(prec_prev);
+}
+
+/*
+ * Error bound for recursive summation (any ordering, any n).
+ *
+ * Rump, S. Error estimation of floating-point summation and dot product.
+ * BIT Numer Math (2012) 52:201-220.
+ */
+
+void arpra_sum_recursive (arpra_range *y, arpra_range *x, arpra_uint n)
+{
+    mpfr_t temp1, temp2;
+    mpfr_ptr sum_x, *sum_x_ptr;
+    arpra_prec prec_internal;
+    arpra_uint i;
+
+    if (sum_special(y, x, n)) {
+        return;
     }
 
     // Initialise vars.
@@ -230,9 +499,8 @@ void arpra_sum_recursive (arpra_range *y, arpra_range *x, arpra_uint n)
     mpfr_sum(temp2, sum_x_ptr, n, MPFR_RNDU);
     mpfr_mul(temp1, temp1, temp2, MPFR_RNDU);
 
-    // Sum x, then add recursive sum error.
-    arpra_sum(y, x, n);
-    arpra_increase(y, y, temp1);
+    // Sum x, adding recursive sum error to the new error term.
+    sum_n(y, x, n, temp1);
 
     // Clear vars.
     mpfr_clear(temp1);
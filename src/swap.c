@@ -0,0 +1,40 @@
+/*
+ * swap.c -- Swap two Arpra ranges.
+ *
+ * Copyright 2016-2020 James Paul Turner.
+ *
+ * This file is part of the Arpra library.
+ *
+ * The Arpra library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Arpra library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with the Arpra library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "arpra-impl.h"
+
+void arpra_swap (arpra_range *x1, arpra_range *x2)
+{
+    arpra_range temp;
+
+    temp = *x1;
+    *x1 = *x2;
+    *x2 = temp;
+
+    // Per-range settings stay with each range.
+    x2->deviation_precision = x1->deviation_precision;
+    x2->internal_precision = x1->internal_precision;
+    x2->range_method = x1->range_method;
+    x1->deviation_precision = temp.deviation_precision;
+    x1->internal_precision = temp.internal_precision;
+    x1->range_method = temp.range_method;
+}
@@ -0,0 +1,74 @@
+/*
+ * symbol_class.c -- Noise symbol classes.
+ *
+ * Copyright 2016-2020 James Paul Turner.
+ *
+ * This file is part of the Arpra library.
+ *
+ * The Arpra library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Arpra library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with the Arpra library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "arpra-impl.h"
+
+/*
+ * Symbols minted by arpra_set_mpfi and arpra_increase are given the class
+ * set here. Other operations mint ARPRA_SYMBOL_ROUNDING symbols, or
+ * ARPRA_SYMBOL_APPROXIMATION symbols if their error includes a nonlinear
+ * approximation error. Reductions only condense terms whose class bit is
+ * set in reduce_classes, or in the calling thread's local mask if it is
+ * not zero.
+ */
+
+static arpra_symbol_class symbol_class = ARPRA_DEFAULT_SYMBOL_CLASS;
+static unsigned int reduce_classes = ARPRA_DEFAULT_REDUCE_CLASSES;
+static ARPRA_THREAD_LOCAL unsigned int reduce_classes_local = 0;
+
+arpra_symbol_class arpra_get_symbol_class ()
+{
+    return symbol_class;
+}
+
+void arpra_set_symbol_class (arpra_symbol_class new_symbol_class)
+{
+    symbol_class = new_symbol_class;
+}
+
+unsigned int arpra_get_reduce_classes ()
+{
+    return reduce_classes;
+}
+
+void arpra_set_reduce_classes (unsigned int new_reduce_classes)
+{
+    reduce_classes = new_reduce_classes;
+}
+
+arpra_symbol_class arpra_get_term_class (const arpra_range *x1, arpra_uint i)
+{
+    return ARPRA_SYMBOL_CLASS(x1->symbols[i]);
+}
+
+void arpra_helper_set_reduce_classes_local (unsigned int classes)
+{
+    reduce_classes_local = classes;
+}
+
+int arpra_helper_reducible_p (arpra_symbol symbol)
+{
+    if (reduce_classes_local != 0) {
+        return (reduce_classes_local >> ARPRA_SYMBOL_CLASS(symbol)) & 1;
+    }
+    return (reduce_classes >> ARPRA_SYMBOL_CLASS(symbol)) & 1;
+}
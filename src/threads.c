@@ -0,0 +1,248 @@
+/*
+ * threads.c -- Thread pool for parallel evaluation in Arpra.
+ *
+ * Copyright 2016-2020 James Paul Turner.
+ *
+ * This file is part of the Arpra library.
+ *
+ * The Arpra library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Arpra library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with the Arpra library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "arpra-impl.h"
+#include <pthread.h>
+
+static arpra_uint threads = ARPRA_DEFAULT_THREADS;
+static ARPRA_THREAD_LOCAL int pool_busy = 0;
+static ARPRA_THREAD_LOCAL arpra_uint pool_index = 0;
+
+// Work is split into one queue per active worker. A worker pops tasks from
+// the front of its own queue, and steals from the front of the other queues
+// once its own queue is empty. Workers past the active count sit the job out.
+static struct
+{
+    pthread_t *thread;
+    arpra_uint workers;
+    arpra_uint active;
+    pthread_mutex_t lock;
+    pthread_cond_t start;
+    pthread_cond_t done;
+    arpra_uint generation;
+    arpra_uint running;
+    int quit;
+    arpra_helper_task fn;
+    void *arg;
+    arpra_uint *next;
+    arpra_uint *end;
+    arpra_uint *counter;
+    arpra_uint base;
+    arpra_uint stride;
+} pool = {
+    .thread = NULL,
+    .workers = 0,
+    .lock = PTHREAD_MUTEX_INITIALIZER,
+    .start = PTHREAD_COND_INITIALIZER,
+    .done = PTHREAD_COND_INITIALIZER,
+};
+
+static void pool_run (arpra_uint worker)
+{
+    arpra_uint victim, tries, i;
+
+    if (worker >= pool.active) {
+        return;
+    }
+
+    pool_busy = 1;
+    pool_index = worker;
+    for (victim = worker, tries = 0; tries < pool.active; ) {
+        i = __atomic_fetch_add(&(pool.next[victim]), 1, __ATOMIC_RELAXED);
+        if (i < pool.end[victim]) {
+            // Noise symbols are taken from a private counter for this task.
+            pool.counter[i] = pool.base + i * pool.stride;
+            arpra_helper_set_symbol_local(&(pool.counter[i]), pool.counter[i] + pool.stride);
+            pool.fn(pool.arg, i);
+            arpra_helper_set_symbol_local(NULL, 0);
+        }
+        else {
+            victim = (victim + 1) % pool.active;
+            tries++;
+        }
+    }
+    pool_busy = 0;
+}
+
+static void *pool_worker (void *arg)
+{
+    arpra_uint worker, generation;
+
+    worker = (arpra_uint) arg;
+    generation = 0;
+
+    for (;;) {
+        pthread_mutex_lock(&(pool.lock));
+        while ((pool.generation == generation) && !pool.quit) {
+            pthread_cond_wait(&(pool.start), &(pool.lock));
+        }
+        if (pool.quit) {
+            pthread_mutex_unlock(&(pool.lock));
+            break;
+        }
+        generation = pool.generation;
+        pthread_mutex_unlock(&(pool.lock));
+
+        pool_run(worker);
+
+        pthread_mutex_lock(&(pool.lock));
+        if (--pool.running == 0) {
+            pthread_cond_signal(&(pool.done));
+        }
+        pthread_mutex_unlock(&(pool.lock));
+    }
+
+    arpra_helper_clear_buffers();
+    return NULL;
+}
+
+static void pool_create ()
+{
+    arpra_uint worker;
+
+    pool.workers = threads;
+    pool.thread = malloc(pool.workers * sizeof(pthread_t));
+    pool.next = malloc(pool.workers * sizeof(arpra_uint));
+    pool.end = malloc(pool.workers * sizeof(arpra_uint));
+    pool.generation = 0;
+    pool.quit = 0;
+
+    // Worker 0 is the calling thread.
+    for (worker = 1; worker < pool.workers; worker++) {
+        pthread_create(&(pool.thread[worker]), NULL, &pool_worker, (void *) worker);
+    }
+}
+
+void arpra_helper_clear_pool ()
+{
+    arpra_uint worker;
+
+    if (pool.workers > 0) {
+        pthread_mutex_lock(&(pool.lock));
+        pool.quit = 1;
+        pthread_cond_broadcast(&(pool.start));
+        pthread_mutex_unlock(&(pool.lock));
+        for (worker = 1; worker < pool.workers; worker++) {
+            pthread_join(pool.thread[worker], NULL);
+        }
+        free(pool.thread);
+        free(pool.next);
+        free(pool.end);
+        pool.workers = 0;
+    }
+}
+
+void arpra_helper_parallel_for (arpra_helper_task fn, void *arg, arpra_uint n, arpra_uint workers,
+                                arpra_range **y, arpra_uint grps, const arpra_uint *dims)
+{
+    arpra_uint i, worker, active, chunk, x_grp, x_dim, i_y, symbol, offset, base, stride;
+
+    // Use at most workers threads, or all of them if workers is zero.
+    active = ((workers > 0) && (workers < threads)) ? workers : threads;
+
+    // Task i takes symbols from [base + i stride, base + (i + 1) stride).
+    base = arpra_helper_get_symbol_count();
+    stride = ((ARPRA_SYMBOL_MAX - base) / (n + 1)) & ~ARPRA_SYMBOL_CLASS_MASK;
+
+    // Run small jobs, jobs started by a task, and jobs with too few symbols
+    // left to give each task a window, in the calling thread.
+    if ((active <= 1) || (n <= 1) || pool_busy || (stride <= ARPRA_SYMBOL_CLASS_MASK)) {
+        for (i = 0; i < n; i++) {
+            fn(arg, i);
+        }
+        return;
+    }
+
+    if (pool.workers != threads) {
+        arpra_helper_clear_pool();
+        pool_create();
+    }
+
+    // Fill worker queues.
+    pool.active = active;
+    chunk = n / active;
+    for (worker = 0; worker < active; worker++) {
+        pool.next[worker] = worker * chunk;
+        pool.end[worker] = (worker + 1) * chunk;
+    }
+    pool.end[active - 1] = n;
+
+    pool.fn = fn;
+    pool.arg = arg;
+    pool.counter = malloc(n * sizeof(arpra_uint));
+    pool.base = base;
+    pool.stride = stride;
+
+    // Start workers, and join in as worker 0.
+    pthread_mutex_lock(&(pool.lock));
+    pool.generation++;
+    pool.running = pool.workers - 1;
+    pthread_cond_broadcast(&(pool.start));
+    pthread_mutex_unlock(&(pool.lock));
+    pool_run(0);
+    pthread_mutex_lock(&(pool.lock));
+    while (pool.running > 0) {
+        pthread_cond_wait(&(pool.done), &(pool.lock));
+    }
+    pthread_mutex_unlock(&(pool.lock));
+
+    // Offset of task i symbols in serial order.
+    for (i = 0, offset = pool.base; i < n; i++) {
+        symbol = pool.counter[i] - (pool.base + i * pool.stride);
+        pool.counter[i] = offset;
+        offset += symbol;
+    }
+
+    // Renumber private symbols as if the tasks had been run in order.
+    if (y != NULL) {
+        for (x_grp = 0; x_grp < grps; x_grp++) {
+            for (x_dim = 0; x_dim < dims[x_grp]; x_dim++) {
+                for (i_y = 0; i_y < y[x_grp][x_dim].nTerms; i_y++) {
+                    symbol = y[x_grp][x_dim].symbols[i_y];
+                    if (symbol >= pool.base) {
+                        arpra_helper_own_terms(&(y[x_grp][x_dim]));
+                        i = (symbol - pool.base) / pool.stride;
+                        symbol -= pool.base + i * pool.stride;
+                        y[x_grp][x_dim].symbols[i_y] = pool.counter[i] + symbol;
+                    }
+                }
+            }
+        }
+    }
+    arpra_helper_set_symbol_count(offset);
+
+    free(pool.counter);
+}
+
+arpra_uint arpra_helper_get_worker ()
+{
+    return pool_index;
+}
+
+arpra_uint arpra_get_threads ()
+{
+    return threads;
+}
+
+void arpra_set_threads (arpra_uint n)
+{
+    threads = (n > 0) ? n : 1;
+}
@@ -33,25 +33,26 @@ void test_rand_arpra (arpra_range *y, test_rand_mode mode_c, test_rand_mode mode
     mpfr_init2(error, prec_internal);
     arpra_init2(&yy, y->precision);
     mpfr_set_zero(error, 1);
+    mpfr_set_zero(&(yy.radius), 1);
 
     // y[0] = rand()
     test_rand_mpfr(&(yy.centre), prec_internal, mode_c);
 
     // Allocate 0 to 9 terms.
     yy.nTerms = gmp_urandomm_ui(test_randstate, 10);
-    yy.symbols = malloc((yy.nTerms + 1) * sizeof(arpra_uint));
-    yy.deviations = malloc((yy.nTerms + 1) * sizeof(mpfr_t));
+    arpra_helper_alloc_terms(&yy, yy.nTerms + 1);
 
     for (iy = 0; iy < yy.nTerms; iy++) {
         mpfr_init2(&(yy.deviations[iy]), prec_internal);
 
         // y[i] = rand()
-        yy.symbols[iy] = arpra_helper_next_symbol();
+        yy.symbols[iy] = arpra_helper_next_symbol(ARPRA_SYMBOL_INPUT);
         test_rand_mpfr(&(yy.deviations[iy]), prec_internal, mode_d);
+        ARPRA_RADIUS_ADD(&(yy.radius), &(yy.deviations[iy]));
     }
 
     // Store new deviation term.
-    yy.symbols[iy] = arpra_helper_next_symbol();
+    yy.symbols[iy] = arpra_helper_next_symbol(ARPRA_SYMBOL_ROUNDING);
     yy.deviations[iy] = *error;
     yy.nTerms = iy + 1;
 
@@ -80,25 +81,26 @@ void test_rand_uniform_arpra (arpra_range *y,
     mpfr_init2(error, prec_internal);
     arpra_init2(&yy, y->precision);
     mpfr_set_zero(error, 1);
+    mpfr_set_zero(&(yy.radius), 1);
 
     // y[0] = rand()
     test_rand_uniform_mpfr(&(yy.centre), yc_a, yc_b);
 
     // Allocate 0 to 9 terms.
     yy.nTerms = gmp_urandomm_ui(test_randstate, 10);
-    yy.symbols = malloc((yy.nTerms + 1) * sizeof(arpra_uint));
-    yy.deviations = malloc((yy.nTerms + 1) * sizeof(mpfr_t));
+    arpra_helper_alloc_terms(&yy, yy.nTerms + 1);
 
     for (iy = 0; iy < yy.nTerms; iy++) {
         mpfr_init2(&(yy.deviations[iy]), prec_internal);
 
         // y[i] = rand()
-        yy.symbols[iy] = arpra_helper_next_symbol();
+        yy.symbols[iy] = arpra_helper_next_symbol(ARPRA_SYMBOL_INPUT);
         test_rand_uniform_mpfr(&(yy.deviations[iy]), yd_a, yd_b);
+        ARPRA_RADIUS_ADD(&(yy.radius), &(yy.deviations[iy]));
     }
 
     // Store new deviation term.
-    yy.symbols[iy] = arpra_helper_next_symbol();
+    yy.symbols[iy] = arpra_helper_next_symbol(ARPRA_SYMBOL_ROUNDING);
     yy.deviations[iy] = *error;
     yy.nTerms = iy + 1;
 
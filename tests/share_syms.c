@@ -23,7 +23,8 @@
 
 void test_share_all_syms (arpra_range *x1, arpra_range *x2)
 {
-    arpra_uint symbol, i;
+    arpra_symbol symbol;
+    arpra_uint i;
     int x1_has_next, x2_has_next;
 
     i = 0;
@@ -31,7 +32,7 @@ void test_share_all_syms (arpra_range *x1, arpra_range *x2)
     x2_has_next = x2->nTerms > 0;
 
     while (x1_has_next || x2_has_next) {
-        symbol = arpra_helper_next_symbol();
+        symbol = arpra_helper_next_symbol(ARPRA_SYMBOL_INPUT);
 
         // Share all x1 and x2 symbols.
         if (x1_has_next) {
@@ -49,7 +50,8 @@ void test_share_all_syms (arpra_range *x1, arpra_range *x2)
 
 void test_share_rand_syms (arpra_range *x1, arpra_range *x2)
 {
-    arpra_uint symbol, i;
+    arpra_symbol symbol;
+    arpra_uint i;
     int x1_has_next, x2_has_next;
 
     i = 0;
@@ -57,7 +59,7 @@ void test_share_rand_syms (arpra_range *x1, arpra_range *x2)
     x2_has_next = x2->nTerms > 0;
 
     while (x1_has_next || x2_has_next) {
-        symbol = arpra_helper_next_symbol();
+        symbol = arpra_helper_next_symbol(ARPRA_SYMBOL_INPUT);
 
         // Randomly share x1 and x2 symbols.
         if (x1_has_next && x2_has_next) {
@@ -67,7 +69,7 @@ void test_share_rand_syms (arpra_range *x1, arpra_range *x2)
             }
             else {
                 x1->symbols[i] = symbol;
-                x2->symbols[i] = arpra_helper_next_symbol();
+                x2->symbols[i] = arpra_helper_next_symbol(ARPRA_SYMBOL_INPUT);
             }
         }
 
@@ -89,7 +91,8 @@ void test_share_rand_syms (arpra_range *x1, arpra_range *x2)
 
 void test_share_n_syms (arpra_range *x1, arpra_range *x2, arpra_uint n)
 {
-    arpra_uint symbol, i;
+    arpra_symbol symbol;
+    arpra_uint i;
     int x1_has_next, x2_has_next;
 
     i = 0;
@@ -97,7 +100,7 @@ void test_share_n_syms (arpra_range *x1, arpra_range *x2, arpra_uint n)
     x2_has_next = x2->nTerms > 0;
 
     while (x1_has_next || x2_has_next) {
-        symbol = arpra_helper_next_symbol();
+        symbol = arpra_helper_next_symbol(ARPRA_SYMBOL_INPUT);
 
         // Share the first n symbols in x1 and x2.
         if (x1_has_next && x2_has_next) {
@@ -108,7 +111,7 @@ void test_share_n_syms (arpra_range *x1, arpra_range *x2, arpra_uint n)
             }
             else {
                 x1->symbols[i] = symbol;
-                x2->symbols[i] = arpra_helper_next_symbol();
+                x2->symbols[i] = arpra_helper_next_symbol(ARPRA_SYMBOL_INPUT);
             }
         }
 
@@ -0,0 +1,177 @@
+/*
+ * t_adaptive_collapse.c -- Test adaptive collapse of affine ranges.
+ *
+ * Copyright 2017-2020 James Paul Turner.
+ *
+ * This file is part of the Arpra library.
+ *
+ * The Arpra library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Arpra library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with the Arpra library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "arpra-test.h"
+
+#define TEST_MAX_OPS 4
+#define TEST_MAX_TERMS 8
+
+// Do the range and affine range of y both contain the range x1?
+static int test_encloses (const arpra_range *y, mpfi_srcptr x1)
+{
+    mpfr_t lo, hi;
+    int encloses;
+
+    mpfr_init2(lo, 2 * mpfr_get_prec(&(y->centre)));
+    mpfr_init2(hi, 2 * mpfr_get_prec(&(y->centre)));
+    mpfr_sub(lo, &(y->centre), &(y->radius), MPFR_RNDD);
+    mpfr_add(hi, &(y->centre), &(y->radius), MPFR_RNDU);
+    encloses = mpfi_is_inside(x1, &(y->true_range))
+        && mpfr_lessequal_p(lo, &(x1->left)) && mpfr_greaterequal_p(hi, &(x1->right));
+    mpfr_clear(lo);
+    mpfr_clear(hi);
+
+    return encloses;
+}
+
+int main (int argc, char *argv[])
+{
+    const arpra_prec prec = 24;
+    const arpra_prec prec_internal = 256;
+    const arpra_uint test_n = 100000;
+    arpra_range z_A;
+    mpfi_t before;
+    mpfr_t width;
+    arpra_uint i, step, ratio, ops, terms, streak, count, fail, fail_n;
+    int wide, collapsed;
+
+    // Init test.
+    test_fixture_init(prec, prec_internal);
+    test_log_init("adaptive_collapse");
+    test_rand_init();
+    arpra_init2(&z_A, prec);
+    mpfi_init2(before, prec);
+    mpfr_init2(width, prec_internal);
+    arpra_set_adaptive_collapse(1);
+    fail_n = 0;
+
+    // Run test.
+    for (i = 0; i < test_n; i++) {
+        fail = 0;
+        ratio = 1 + gmp_urandomm_ui(test_randstate, 4);
+        ops = 1 + gmp_urandomm_ui(test_randstate, TEST_MAX_OPS);
+        terms = 1 + gmp_urandomm_ui(test_randstate, TEST_MAX_TERMS);
+        arpra_set_collapse_ratio(ratio);
+
+        test_log_printf("Test %lu: ratio %lu, ops %lu, terms %lu.\n", i, ratio, ops, terms);
+
+        // Streak: y is wide or narrow at random, until it collapses.
+        arpra_set_collapse_ops(ops);
+        arpra_set_collapse_terms(-1);
+
+        // The radius must be wide enough to narrow at the precision of y.
+        do {
+            test_rand_arpra(&y_A, TEST_RAND_MIXED, TEST_RAND_SMALL);
+            mpfr_abs(width, &(y_A.centre), MPFR_RNDU);
+            mpfr_div_2ui(width, width, prec / 2, MPFR_RNDU);
+        } while (!arpra_bounded_p(&y_A) || mpfr_zero_p(&(y_A.radius))
+                 || mpfr_less_p(&(y_A.radius), width));
+        y_A.wide_ops = 0;
+        streak = 0;
+        for (step = 0, collapsed = 0; !collapsed && (step < 2 * TEST_MAX_OPS); step++) {
+            // Wide ranges are narrowed to 1 / (2 ratio) of the affine width,
+            // and narrow ranges are the affine range.
+            wide = gmp_urandomb_ui(test_randstate, 1);
+            if (wide) {
+                mpfr_div_ui(width, &(y_A.radius), 2 * ratio, MPFR_RNDD);
+                mpfr_sub(&(y_A.true_range.left), &(y_A.centre), width, MPFR_RNDU);
+                mpfr_add(&(y_A.true_range.right), &(y_A.centre), width, MPFR_RNDD);
+            }
+            else {
+                mpfr_sub(&(y_A.true_range.left), &(y_A.centre), &(y_A.radius), MPFR_RNDD);
+                mpfr_add(&(y_A.true_range.right), &(y_A.centre), &(y_A.radius), MPFR_RNDU);
+            }
+            mpfi_set(before, &(y_A.true_range));
+            streak = wide ? (streak + 1) : 0;
+
+            count = arpra_get_adaptive_collapse_count();
+            collapsed = arpra_helper_adaptive_collapse(&y_A);
+            test_log_printf("Step %lu: %s, wide_ops %lu.\n", step, wide ? "wide" : "narrow", y_A.wide_ops);
+
+            // Pass criteria:
+            // 1) Wide operations extend the streak, and others reset it.
+            if (!collapsed && (y_A.wide_ops != streak)) {
+                test_log_printf("Streak: FAIL\n");
+                fail = 1;
+            }
+
+            // 2) y collapses exactly when the streak reaches the collapse ops.
+            if (collapsed != (streak >= ops)) {
+                test_log_printf("Collapse ops: FAIL\n");
+                fail = 1;
+            }
+
+            // 3) A collapse is counted, and y encloses its range before.
+            if (arpra_get_adaptive_collapse_count() != (count + collapsed)) {
+                test_log_printf("Collapse count: FAIL\n");
+                fail = 1;
+            }
+            if (collapsed && ((y_A.nTerms != 1) || !test_encloses(&y_A, before))) {
+                test_log_printf("Collapsed range: FAIL\n");
+                fail = 1;
+            }
+        }
+
+        // Terms: y = x1 + x2 collapses if it has more than collapse terms terms.
+        arpra_set_collapse_ops(-1);
+        test_rand_arpra(&x1_A, TEST_RAND_MIXED, TEST_RAND_SMALL);
+        test_rand_arpra(&x2_A, TEST_RAND_MIXED, TEST_RAND_SMALL);
+        arpra_set_adaptive_collapse(0);
+        arpra_add(&z_A, &x1_A, &x2_A);
+        arpra_set_adaptive_collapse(1);
+        arpra_set_collapse_terms(terms);
+        count = arpra_get_adaptive_collapse_count();
+        arpra_add(&y_A, &x1_A, &x2_A);
+        collapsed = arpra_bounded_p(&z_A) && (z_A.nTerms > terms);
+        test_log_printf("Add: %lu terms without collapse.\n", z_A.nTerms);
+        test_log_mpfi(&(z_A.true_range), "z_A");
+        test_log_mpfi(&(y_A.true_range), "y_A");
+
+        // 4) y collapses exactly when it would have too many terms.
+        if (arpra_get_adaptive_collapse_count() != (count + collapsed)) {
+            test_log_printf("Collapse terms: FAIL\n");
+            fail = 1;
+        }
+
+        // 5) A collapsed y encloses the range it would have had.
+        if (collapsed && ((y_A.nTerms != 1) || !test_encloses(&y_A, &(z_A.true_range)))) {
+            test_log_printf("Collapsed range: FAIL\n");
+            fail = 1;
+        }
+
+        test_log_printf("Result: %s\n\n", fail ? "FAIL" : "PASS");
+        if (fail) fail_n++;
+    }
+
+    // Cleanup test.
+    printf("%lu out of %lu failed.\n", fail_n, test_n);
+    arpra_set_adaptive_collapse(0);
+    arpra_set_collapse_ratio(ARPRA_DEFAULT_COLLAPSE_RATIO);
+    arpra_set_collapse_ops(ARPRA_DEFAULT_COLLAPSE_OPS);
+    arpra_set_collapse_terms(ARPRA_DEFAULT_COLLAPSE_TERMS);
+    arpra_clear(&z_A);
+    mpfi_clear(before);
+    mpfr_clear(width);
+    test_fixture_clear();
+    test_log_clear();
+    test_rand_clear();
+    return fail_n > 0;
+}
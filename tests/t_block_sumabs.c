@@ -0,0 +1,165 @@
+/*
+ * t_block_sumabs.c -- Test the arpra_helper_block_sumabs function.
+ *
+ * Copyright 2017-2020 James Paul Turner.
+ *
+ * This file is part of the Arpra library.
+ *
+ * The Arpra library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Arpra library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with the Arpra library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "arpra-test.h"
+
+#define TEST_MAX_N 64
+#define TEST_LARGE_N 20000
+
+int main (int argc, char *argv[])
+{
+    const arpra_prec prec = 53;
+    const arpra_prec prec_internal = 256;
+    const arpra_prec prec_exact = 4096;
+    const long spreads[] = {0, 10, 1000, 100000};
+    const arpra_uint test_n = 100000;
+    mpfr_t y, exact, bound;
+    mpfr_ptr x, *x_abs;
+    arpra_prec prec_x, prec_y;
+    arpra_uint i, j, n, fail, fail_n;
+    long spread;
+    int has_nan, has_inf;
+
+    // Init test.
+    test_fixture_init(prec, prec_internal);
+    test_log_init("block_sumabs");
+    test_rand_init();
+    mpfr_init2(exact, prec_exact);
+    mpfr_init2(bound, prec_exact);
+    x = malloc(TEST_LARGE_N * sizeof(mpfr_t));
+    x_abs = malloc(TEST_LARGE_N * sizeof(mpfr_ptr));
+    for (j = 0; j < TEST_LARGE_N; j++) {
+        mpfr_init2(&(x[j]), 256);
+        x_abs[j] = &(x[j]);
+    }
+    fail_n = 0;
+
+    // Run test.
+    for (i = 0; i < test_n; i++) {
+        fail = 0;
+
+        // Mostly short arrays, with the odd large one.
+        if (gmp_urandomm_ui(test_randstate, 1000) == 0) {
+            n = TEST_LARGE_N;
+        }
+        else {
+            n = 1 + gmp_urandomm_ui(test_randstate, TEST_MAX_N);
+        }
+        spread = spreads[gmp_urandomm_ui(test_randstate, 4)];
+        prec_y = (gmp_urandomb_ui(test_randstate, 1)) ? 53 : 256;
+        mpfr_init2(y, prec_y);
+
+        // Random terms, with some zeros and all-ones significands.
+        has_nan = 0;
+        has_inf = 0;
+        for (j = 0; j < n; j++) {
+            prec_x = 24 + gmp_urandomm_ui(test_randstate, 233);
+            mpfr_set_prec(&(x[j]), prec_x);
+            switch (gmp_urandomm_ui(test_randstate, 8)) {
+            case 0:
+                mpfr_set_zero(&(x[j]), 1);
+                break;
+            case 1:
+                mpfr_set_ui(&(x[j]), 1, MPFR_RNDN);
+                mpfr_nextbelow(&(x[j]));
+                break;
+            default:
+                mpfr_urandomb(&(x[j]), test_randstate);
+                break;
+            }
+            mpfr_mul_2si(&(x[j]), &(x[j]), (long) gmp_urandomm_ui(test_randstate, 2 * spread + 1) - spread, MPFR_RNDN);
+            if (gmp_urandomb_ui(test_randstate, 1)) {
+                mpfr_neg(&(x[j]), &(x[j]), MPFR_RNDN);
+            }
+        }
+        if (gmp_urandomm_ui(test_randstate, 50) == 0) {
+            j = gmp_urandomm_ui(test_randstate, n);
+            if (gmp_urandomb_ui(test_randstate, 1)) {
+                mpfr_set_nan(&(x[j]));
+                has_nan = 1;
+            }
+            else {
+                mpfr_set_inf(&(x[j]), -1);
+                has_inf = 1;
+            }
+        }
+
+        test_log_printf("Test %lu: %lu terms, spread %ld, precision %lu.\n", i, n, spread, prec_y);
+
+        arpra_helper_block_sumabs(y, x, n);
+        test_log_mpfr(y, "y");
+
+        // Pass criteria:
+        // 1) NaN terms give NaN, and infinite terms give +Inf.
+        if (has_nan || has_inf) {
+            if (has_nan ? !mpfr_nan_p(y) : !(mpfr_inf_p(y) && (mpfr_sgn(y) > 0))) {
+                test_log_printf("NaN/Inf: FAIL\n");
+                fail = 1;
+            }
+        }
+        else {
+            // exact = |x[0]| + ... + |x[n-1]|
+            for (j = 0; j < n; j++) {
+                mpfr_abs(&(x[j]), &(x[j]), MPFR_RNDN);
+            }
+            mpfr_sum(exact, x_abs, n, MPFR_RNDU);
+            test_log_mpfr(exact, "exact");
+
+            // 2) y is at least the sum of |x| rounded up to the precision of y.
+            mpfr_set(bound, exact, MPFR_RNDU);
+            mpfr_prec_round(bound, prec_y, MPFR_RNDU);
+            if (mpfr_less_p(y, bound)) {
+                test_log_printf("Upper bound: FAIL\n");
+                fail = 1;
+            }
+
+            // 3) y is not much looser than the exact sum.
+            mpfr_set_prec(bound, prec_exact);
+            mpfr_mul_2si(bound, exact, -61, MPFR_RNDU);
+            mpfr_mul_ui(bound, bound, 2 * n + 64, MPFR_RNDU);
+            mpfr_add(bound, bound, exact, MPFR_RNDU);
+            mpfr_prec_round(bound, prec_y, MPFR_RNDU);
+            if (mpfr_greater_p(y, bound)) {
+                test_log_printf("Tightness: FAIL\n");
+                fail = 1;
+            }
+            mpfr_set_prec(bound, prec_exact);
+        }
+
+        test_log_printf("Result: %s\n\n", fail ? "FAIL" : "PASS");
+        if (fail) fail_n++;
+        mpfr_clear(y);
+    }
+
+    // Cleanup test.
+    printf("%lu out of %lu failed.\n", fail_n, test_n);
+    mpfr_clear(exact);
+    mpfr_clear(bound);
+    for (j = 0; j < TEST_LARGE_N; j++) {
+        mpfr_clear(&(x[j]));
+    }
+    free(x);
+    free(x_abs);
+    test_fixture_clear();
+    test_log_clear();
+    test_rand_clear();
+    return fail_n > 0;
+}
@@ -0,0 +1,146 @@
+/*
+ * t_dense.c -- Test conversion between Arpra ranges and dense vectors.
+ *
+ * Copyright 2017-2020 James Paul Turner.
+ *
+ * This file is part of the Arpra library.
+ *
+ * The Arpra library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Arpra library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with the Arpra library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "arpra-test.h"
+
+#define TEST_DIMS 3
+
+// Does y contain x1, with the centre and non-zero deviation terms of x1, and
+// no other terms except its own error term?
+static int test_same_terms (const arpra_range *y, const arpra_range *x1)
+{
+    arpra_uint i_y, i_x1;
+
+    if (arpra_nan_p(x1)) {
+        return arpra_nan_p(y);
+    }
+    if (arpra_inf_p(x1)) {
+        return arpra_inf_p(y) && !arpra_nan_p(y);
+    }
+    if (!mpfr_equal_p(&(y->centre), &(x1->centre))
+            || mpfr_greater_p(&(y->true_range.left), &(x1->true_range.left))
+            || mpfr_less_p(&(y->true_range.right), &(x1->true_range.right))) {
+        return 0;
+    }
+    for (i_y = 0, i_x1 = 0; i_x1 < x1->nTerms; i_x1++) {
+        if (!mpfr_zero_p(&(x1->deviations[i_x1]))) {
+            if ((i_y == y->nTerms)
+                    || (y->symbols[i_y] != x1->symbols[i_x1])
+                    || !mpfr_equal_p(&(y->deviations[i_y]), &(x1->deviations[i_x1]))) {
+                return 0;
+            }
+            i_y++;
+        }
+    }
+    return (i_y + 1) == y->nTerms;
+}
+
+int main (int argc, char *argv[])
+{
+    const arpra_prec prec = 24;
+    const arpra_prec prec_internal = 256;
+    const arpra_uint test_n = 100000;
+    arpra_range x[TEST_DIMS], y[TEST_DIMS];
+    arpra_dense x_D, y_D;
+    __mpfr_struct a[TEST_DIMS * TEST_DIMS];
+    arpra_uint i, j, fail, fail_n;
+
+    // Init test.
+    test_fixture_init(prec, prec_internal);
+    test_log_init("dense");
+    test_rand_init();
+    for (j = 0; j < TEST_DIMS; j++) {
+        arpra_init2(&x[j], prec);
+        arpra_init2(&y[j], prec);
+    }
+    for (j = 0; j < (TEST_DIMS * TEST_DIMS); j++) {
+        mpfr_init2(&(a[j]), 2);
+        mpfr_set_ui(&(a[j]), ((j % (TEST_DIMS + 1)) == 0), MPFR_RNDN);
+    }
+    arpra_dense_init2(&x_D, TEST_DIMS, prec);
+    arpra_dense_init2(&y_D, TEST_DIMS, prec);
+    fail_n = 0;
+
+    // Run test.
+    for (i = 0; i < test_n; i++) {
+        fail = 0;
+
+        // Random ranges with some shared symbols, and an occasional NaN or Inf.
+        test_rand_arpra(&x[0], TEST_RAND_MIXED, TEST_RAND_SMALL);
+        test_rand_arpra(&x[1], TEST_RAND_MIXED, TEST_RAND_SMALL);
+        test_rand_arpra(&x[2], TEST_RAND_MIXED, TEST_RAND_SMALL);
+        test_share_rand_syms(&x[0], &x[1]);
+        switch (gmp_urandomm_ui(test_randstate, 20)) {
+        case 0:
+            arpra_set_nan(&x[2]);
+            break;
+        case 1:
+            arpra_set_inf(&x[2]);
+            break;
+        }
+
+        test_log_printf("Test %lu:\n", i);
+        for (j = 0; j < TEST_DIMS; j++) {
+            test_log_mpfi(&(x[j].true_range), "x");
+        }
+
+        // Pass criteria:
+        // 1) Ranges set from a dense vector set from ranges are unchanged.
+        arpra_dense_set_range(&x_D, x);
+        arpra_dense_get_range(y, &x_D);
+        for (j = 0; j < TEST_DIMS; j++) {
+            test_log_mpfi(&(y[j].true_range), "y");
+            if (!test_same_terms(&y[j], &x[j])) {
+                test_log_printf("Round trip %lu: FAIL\n", j);
+                fail = 1;
+            }
+        }
+
+        // 2) The identity map of a dense vector leaves it unchanged.
+        arpra_dense_affine(&y_D, a, &x_D, NULL);
+        arpra_dense_get_range(y, &y_D);
+        for (j = 0; j < TEST_DIMS; j++) {
+            if (!test_same_terms(&y[j], &x[j])) {
+                test_log_printf("Identity %lu: FAIL\n", j);
+                fail = 1;
+            }
+        }
+
+        test_log_printf("Result: %s\n\n", fail ? "FAIL" : "PASS");
+        if (fail) fail_n++;
+    }
+
+    // Cleanup test.
+    printf("%lu out of %lu failed.\n", fail_n, test_n);
+    for (j = 0; j < TEST_DIMS; j++) {
+        arpra_clear(&x[j]);
+        arpra_clear(&y[j]);
+    }
+    for (j = 0; j < (TEST_DIMS * TEST_DIMS); j++) {
+        mpfr_clear(&(a[j]));
+    }
+    arpra_dense_clear(&x_D);
+    arpra_dense_clear(&y_D);
+    test_fixture_clear();
+    test_log_clear();
+    test_rand_clear();
+    return fail_n > 0;
+}
@@ -0,0 +1,172 @@
+/*
+ * t_ext_mpfr_mul.c -- Test the arpra_ext_mpfr_mul function.
+ *
+ * Copyright 2017-2020 James Paul Turner.
+ *
+ * This file is part of the Arpra library.
+ *
+ * The Arpra library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Arpra library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with the Arpra library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "arpra-test.h"
+
+#define TEST_MODES 5
+
+// Random significand in [1/2, 1), or one with every bit set.
+static void test_rand_significand (mpfr_ptr y, int ones)
+{
+    if (ones) {
+        mpfr_set_ui(y, 1, MPFR_RNDN);
+        mpfr_nextbelow(y);
+    }
+    else {
+        do {
+            mpfr_urandomb(y, test_randstate);
+        } while (mpfr_cmp_d(y, 0.5) < 0);
+    }
+}
+
+int main (int argc, char *argv[])
+{
+    const arpra_prec prec = 53;
+    const arpra_prec prec_internal = 256;
+    const arpra_uint test_n = 100000;
+    const char *names[TEST_MODES] =
+    {
+        "random", "all ones", "tie", "carry", "extreme exponent"
+    };
+    mpfr_t x1, x2, y, y_ref, target;
+    mpz_t m;
+    arpra_prec prec_op;
+    arpra_uint i, mode, fail, fail_n, carry_n;
+    int ternary, ternary_ref;
+
+    // Init test.
+    test_fixture_init(prec, prec_internal);
+    test_log_init("ext_mpfr_mul");
+    test_rand_init();
+    mpfr_inits2(prec_internal, x1, x2, y, y_ref, target, (mpfr_ptr) NULL);
+    mpz_init(m);
+    fail_n = 0;
+    carry_n = 0;
+
+    // Run test.
+    for (i = 0; i < test_n; i++) {
+        fail = 0;
+        mode = gmp_urandomm_ui(test_randstate, TEST_MODES);
+        prec_op = 128 + 64 * gmp_urandomm_ui(test_randstate, 3);
+        mpfr_set_prec(x1, prec_op);
+        mpfr_set_prec(x2, prec_op);
+        mpfr_set_prec(y, prec_op);
+        mpfr_set_prec(y_ref, prec_op);
+        mpfr_set_prec(target, prec_op + 2);
+
+        switch (mode) {
+        case 0:
+        case 4:
+            test_rand_significand(x1, 0);
+            test_rand_significand(x2, 0);
+            break;
+        case 1:
+            test_rand_significand(x1, 1);
+            test_rand_significand(x2, gmp_urandomb_ui(test_randstate, 1));
+            break;
+        case 2:
+            // 3 m is an exact tie for odd m in [2^(p-1), 2^(p+1) / 3).
+            mpz_set_ui(m, 1);
+            mpz_mul_2exp(m, m, prec_op + 1);
+            mpz_tdiv_q_ui(m, m, 3);
+            mpz_sub_ui(m, m, 1);
+            mpz_urandomm(m, test_randstate, m);
+            mpz_setbit(m, prec_op - 1);
+            mpz_setbit(m, 0);
+            mpfr_set_z(x1, m, MPFR_RNDN);
+            mpfr_set_ui(x2, 3, MPFR_RNDN);
+            break;
+        case 3:
+            // x2 is near (1 - 2^-(p+2)) / x1, so the product often rounds up to 1.
+            test_rand_significand(x1, gmp_urandomb_ui(test_randstate, 1));
+            mpfr_set_ui(target, 1, MPFR_RNDN);
+            mpfr_nextbelow(target);
+            mpfr_div(x2, target, x1, MPFR_RNDN);
+            break;
+        }
+
+        // Random exponents and signs.
+        if (mode == 4) {
+            mpfr_mul_2si(x1, x1, mpfr_get_emax() / 2, MPFR_RNDN);
+            mpfr_mul_2si(x2, x2, mpfr_get_emax() / 2 - 1 + (long) gmp_urandomm_ui(test_randstate, 3), MPFR_RNDN);
+            if (gmp_urandomb_ui(test_randstate, 1)) {
+                mpfr_ui_div(x2, 1, x2, MPFR_RNDN);
+                mpfr_ui_div(x1, 1, x1, MPFR_RNDN);
+            }
+        }
+        else {
+            mpfr_mul_2si(x1, x1, (long) gmp_urandomm_ui(test_randstate, 201) - 100, MPFR_RNDN);
+            mpfr_mul_2si(x2, x2, (long) gmp_urandomm_ui(test_randstate, 201) - 100, MPFR_RNDN);
+        }
+        if (gmp_urandomb_ui(test_randstate, 1)) {
+            mpfr_neg(x1, x1, MPFR_RNDN);
+        }
+        if (gmp_urandomb_ui(test_randstate, 1)) {
+            mpfr_neg(x2, x2, MPFR_RNDN);
+        }
+
+        test_log_printf("Test %lu: %s, precision %lu.\n", i, names[mode], prec_op);
+        test_log_mpfr(x1, "x1");
+        test_log_mpfr(x2, "x2");
+
+        ternary_ref = mpfr_mul(y_ref, x1, x2, MPFR_RNDN);
+        ternary = arpra_ext_mpfr_mul(y, x1, x2, MPFR_RNDN);
+        test_log_mpfr(y_ref, "y_ref");
+        test_log_mpfr(y, "y");
+
+        // Count products rounded up to a power of two.
+        if ((mode == 3) && (mpfr_min_prec(y_ref) == 1) && ((ternary_ref * mpfr_sgn(y_ref)) > 0)) {
+            carry_n++;
+        }
+
+        // Pass criteria:
+        // 1) y is bit-identical to the MPFR product.
+        if (!(mpfr_equal_p(y, y_ref) || (mpfr_nan_p(y) && mpfr_nan_p(y_ref)))
+                || (mpfr_signbit(y) != mpfr_signbit(y_ref))) {
+            test_log_printf("Product: FAIL\n");
+            fail = 1;
+        }
+
+        // 2) The ternary value has the same sign as MPFR's.
+        if (((ternary > 0) - (ternary < 0)) != ((ternary_ref > 0) - (ternary_ref < 0))) {
+            test_log_printf("Ternary: FAIL\n");
+            fail = 1;
+        }
+
+        test_log_printf("Result: %s\n\n", fail ? "FAIL" : "PASS");
+        if (fail) fail_n++;
+    }
+
+    // 3) The carry path was reached.
+    if (carry_n == 0) {
+        test_log_printf("Carry path not reached: FAIL\n");
+        fail_n++;
+    }
+
+    // Cleanup test.
+    printf("%lu out of %lu failed.\n", fail_n, test_n);
+    mpfr_clears(x1, x2, y, y_ref, target, (mpfr_ptr) NULL);
+    mpz_clear(m);
+    test_fixture_clear();
+    test_log_clear();
+    test_rand_clear();
+    return fail_n > 0;
+}
@@ -0,0 +1,126 @@
+/*
+ * t_ode_stepper.c -- Test that ODE steppers keep per-range settings.
+ *
+ * Copyright 2017-2020 James Paul Turner.
+ *
+ * This file is part of the Arpra library.
+ *
+ * The Arpra library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Arpra library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with the Arpra library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "arpra-test.h"
+
+#define TEST_DIMS 3
+#define TEST_STEPS 8
+
+static const arpra_prec test_internal[TEST_DIMS] = {128, 0, 320};
+static const arpra_prec test_deviation[TEST_DIMS] = {64, 0, 96};
+static const arpra_range_method test_method[TEST_DIMS] =
+{
+    ARPRA_IA, ARPRA_GLOBAL_RANGE_METHOD, ARPRA_AA
+};
+
+// dx/dt = -x
+static void test_f (arpra_range *dxdt, const void *params,
+                    const arpra_range *t, const arpra_range **x,
+                    const arpra_uint x_grp, const arpra_uint x_dim)
+{
+    arpra_neg(dxdt, &(x[x_grp][x_dim]));
+}
+
+int main (int argc, char *argv[])
+{
+    const arpra_ode_method *methods[5];
+    const char *names[5] = {"euler", "trapezoidal", "bogsham32", "dopri54", "dopri87"};
+    arpra_range t, h, x[TEST_DIMS];
+    arpra_range *x_grp[1];
+    arpra_uint dims[1] = {TEST_DIMS};
+    arpra_ode_f f[1] = {&test_f};
+    void *params[1] = {NULL};
+    arpra_ode_system system;
+    arpra_ode_stepper stepper;
+    arpra_uint i, j, m, threads, fail, fail_n, test_n;
+
+    methods[0] = arpra_ode_euler;
+    methods[1] = arpra_ode_trapezoidal;
+    methods[2] = arpra_ode_bogsham32;
+    methods[3] = arpra_ode_dopri54;
+    methods[4] = arpra_ode_dopri87;
+
+    // Init test.
+    test_log_init("ode_stepper");
+    arpra_init(&t);
+    arpra_init(&h);
+    fail_n = 0;
+    test_n = 0;
+
+    // Run test.
+    for (threads = 1; threads <= 2; threads++) {
+        arpra_set_threads(threads);
+        for (m = 0; m < 5; m++) {
+            for (j = 0; j < TEST_DIMS; j++) {
+                arpra_init3(&x[j], 53, test_internal[j]);
+                arpra_set_deviation_precision(&x[j], test_deviation[j]);
+                arpra_set_local_range_method(&x[j], test_method[j]);
+                arpra_set_d(&x[j], 1.0 + j);
+            }
+            arpra_set_d(&t, 0);
+            arpra_set_d(&h, 0.125);
+            x_grp[0] = x;
+            system.f = f;
+            system.f_grp = NULL;
+            system.params = params;
+            system.t = &t;
+            system.x = x_grp;
+            system.grps = 1;
+            system.dims = dims;
+            system.worker_params = NULL;
+            system.workers = 0;
+            arpra_ode_stepper_init(&stepper, &system, methods[m]);
+
+            // Pass criteria:
+            // 1) Every state variable keeps its internal precision, deviation
+            //    precision and range method after each step.
+            for (i = 0; i < TEST_STEPS; i++) {
+                arpra_ode_stepper_step(&stepper, &h);
+                fail = 0;
+                for (j = 0; j < TEST_DIMS; j++) {
+                    if ((x[j].internal_precision != test_internal[j])
+                            || (x[j].deviation_precision != test_deviation[j])
+                            || (x[j].range_method != test_method[j])) {
+                        fail = 1;
+                    }
+                }
+                test_log_printf("Method %s, threads %lu, step %lu: %s\n",
+                                names[m], threads, i, fail ? "FAIL" : "PASS");
+                fail_n += fail;
+                test_n++;
+            }
+
+            arpra_ode_stepper_clear(&stepper);
+            for (j = 0; j < TEST_DIMS; j++) {
+                arpra_clear(&x[j]);
+            }
+        }
+    }
+
+    // Cleanup test.
+    printf("%lu out of %lu failed.\n", fail_n, test_n);
+    arpra_set_threads(1);
+    arpra_clear(&t);
+    arpra_clear(&h);
+    arpra_clear_buffers();
+    test_log_clear();
+    return fail_n > 0;
+}
@@ -0,0 +1,182 @@
+/*
+ * t_ode_threads.c -- Test that ODE steps do not depend on the thread count.
+ *
+ * Copyright 2017-2020 James Paul Turner.
+ *
+ * This file is part of the Arpra library.
+ *
+ * The Arpra library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Arpra library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with the Arpra library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "arpra-test.h"
+
+#define TEST_GRPS 2
+#define TEST_DIMS 3
+#define TEST_STEPS 3
+#define TEST_THREADS 3
+#define TEST_WORKERS 2
+
+// Per-thread scratch, and a count of callbacks that found it in use.
+typedef struct test_scratch_struct
+{
+    arpra_range temp;
+    int busy;
+} test_scratch;
+
+static arpra_uint test_clashes = 0;
+
+// dx/dt = ((x + y[0]) * y[0]) - x, where y is the other group. With lazy
+// ranges, y[0] is read by an affine operation before it is summed.
+static void test_f (arpra_range *dxdt, const void *params,
+                    const arpra_range *t, const arpra_range **x,
+                    const arpra_uint x_grp, const arpra_uint x_dim)
+{
+    test_scratch *scratch = (test_scratch *) params;
+    arpra_range *temp = &(scratch->temp);
+
+    if (__atomic_exchange_n(&(scratch->busy), 1, __ATOMIC_ACQUIRE)) {
+        __atomic_add_fetch(&test_clashes, 1, __ATOMIC_RELAXED);
+    }
+    arpra_add(temp, &(x[x_grp][x_dim]), &(x[1 - x_grp][0]));
+    arpra_mul(temp, temp, &(x[1 - x_grp][0]));
+    arpra_sub(dxdt, temp, &(x[x_grp][x_dim]));
+    __atomic_store_n(&(scratch->busy), 0, __ATOMIC_RELEASE);
+}
+
+int main (int argc, char *argv[])
+{
+    const arpra_ode_method *methods[3];
+    const char *names[3] = {"euler", "bogsham32", "dopri54"};
+    arpra_range t, h, x[TEST_GRPS][TEST_DIMS], x_ref[2][TEST_GRPS][TEST_DIMS];
+    arpra_range *x_grp[TEST_GRPS], *x_ptr[TEST_GRPS * TEST_DIMS];
+    arpra_uint dims[TEST_GRPS] = {TEST_DIMS, TEST_DIMS};
+    arpra_ode_f f[TEST_GRPS] = {&test_f, &test_f};
+    test_scratch scratch[TEST_WORKERS];
+    void *params[TEST_WORKERS][TEST_GRPS];
+    void **worker_params[TEST_WORKERS];
+    arpra_ode_system system;
+    arpra_ode_stepper stepper;
+    mpfr_t delta;
+    arpra_uint i, j, m, threads, fail, fail_n, test_n;
+    int lazy;
+
+    methods[0] = arpra_ode_euler;
+    methods[1] = arpra_ode_bogsham32;
+    methods[2] = arpra_ode_dopri54;
+
+    // Init test.
+    test_log_init("ode_threads");
+    arpra_init(&t);
+    arpra_init(&h);
+    mpfr_init2(delta, 53);
+    mpfr_set_d(delta, 0.001, MPFR_RNDU);
+    for (i = 0; i < TEST_WORKERS; i++) {
+        arpra_init(&(scratch[i].temp));
+        scratch[i].busy = 0;
+        params[i][0] = &scratch[i];
+        params[i][1] = &scratch[i];
+        worker_params[i] = params[i];
+    }
+    for (i = 0; i < TEST_GRPS; i++) {
+        x_grp[i] = x[i];
+        for (j = 0; j < TEST_DIMS; j++) {
+            arpra_init(&x_ref[0][i][j]);
+            arpra_init(&x_ref[1][i][j]);
+            x_ptr[(i * TEST_DIMS) + j] = &x[i][j];
+        }
+    }
+    system.f = f;
+    system.f_grp = NULL;
+    system.params = NULL;
+    system.t = &t;
+    system.x = x_grp;
+    system.grps = TEST_GRPS;
+    system.dims = dims;
+    system.worker_params = worker_params;
+    system.workers = TEST_WORKERS;
+    fail_n = 0;
+    test_n = 0;
+
+    // Run test, with and without lazy ranges.
+    for (lazy = 0; lazy <= 1; lazy++) {
+        arpra_set_lazy_range(lazy);
+        for (m = 0; m < 3; m++) {
+            for (threads = 1; threads <= TEST_THREADS; threads++) {
+                arpra_set_threads(threads);
+                for (i = 0; i < TEST_GRPS; i++) {
+                    for (j = 0; j < TEST_DIMS; j++) {
+                        arpra_init(&x[i][j]);
+                        arpra_set_d(&x[i][j], (i ? -0.2 : 0.1) * (j + 1));
+                        arpra_increase(&x[i][j], &x[i][j], delta);
+                    }
+                }
+                arpra_set_d(&t, 0);
+                arpra_set_d(&h, 0.015625);
+                arpra_ode_stepper_init(&stepper, &system, methods[m]);
+                for (i = 0; i < TEST_STEPS; i++) {
+                    arpra_ode_stepper_step(&stepper, &h);
+                }
+                arpra_ode_stepper_clear(&stepper);
+
+                // Number symbols from zero, since each run starts from new ones,
+                // and sum the radius of lazy ranges before comparing them.
+                arpra_renumber_symbols(x_ptr, TEST_GRPS * TEST_DIMS);
+                for (i = 0; i < (TEST_GRPS * TEST_DIMS); i++) {
+                    arpra_helper_update_range(x_ptr[i]);
+                }
+
+                // Pass criteria:
+                // 1) The state after each run is the same as with one thread,
+                //    including its symbols.
+                // 2) No two callbacks used the same scratch at once.
+                fail = __atomic_exchange_n(&test_clashes, 0, __ATOMIC_RELAXED) > 0;
+                for (i = 0; i < TEST_GRPS; i++) {
+                    for (j = 0; j < TEST_DIMS; j++) {
+                        if (threads == 1) {
+                            arpra_set(&x_ref[lazy][i][j], &x[i][j]);
+                        }
+                        else if (test_compare_arpra(&x[i][j], &x_ref[lazy][i][j])) {
+                            fail = 1;
+                        }
+                        arpra_clear(&x[i][j]);
+                    }
+                }
+                test_log_printf("Method %s, %s ranges, threads %lu: %s\n", names[m],
+                                lazy ? "lazy" : "eager", threads, fail ? "FAIL" : "PASS");
+                fail_n += fail;
+                test_n++;
+            }
+        }
+    }
+
+    // Cleanup test.
+    printf("%lu out of %lu failed.\n", fail_n, test_n);
+    arpra_set_threads(1);
+    arpra_set_lazy_range(0);
+    for (i = 0; i < TEST_WORKERS; i++) {
+        arpra_clear(&(scratch[i].temp));
+    }
+    for (i = 0; i < TEST_GRPS; i++) {
+        for (j = 0; j < TEST_DIMS; j++) {
+            arpra_clear(&x_ref[0][i][j]);
+            arpra_clear(&x_ref[1][i][j]);
+        }
+    }
+    arpra_clear(&t);
+    arpra_clear(&h);
+    mpfr_clear(delta);
+    arpra_clear_buffers();
+    test_log_clear();
+    return fail_n > 0;
+}
@@ -0,0 +1,190 @@
+/*
+ * t_range_method.c -- Test the ARPRA_IA method, and per-range method selection.
+ *
+ * Copyright 2017-2020 James Paul Turner.
+ *
+ * This file is part of the Arpra library.
+ *
+ * The Arpra library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Arpra library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with the Arpra library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "arpra-test.h"
+
+#define TEST_OPS 10
+#define TEST_UNIVARIATE_OPS 6
+#define TEST_SELECTIONS 3
+
+typedef void (*test_fn_1) (arpra_range *y, const arpra_range *x1);
+typedef void (*test_fn_2) (arpra_range *y, const arpra_range *x1, const arpra_range *x2);
+typedef int (*test_mpfi_fn_1) (mpfi_ptr y, mpfi_srcptr x1);
+typedef int (*test_mpfi_fn_2) (mpfi_ptr y, mpfi_srcptr x1, mpfi_srcptr x2);
+
+static const test_fn_1 fn_1[TEST_UNIVARIATE_OPS] =
+{
+    arpra_set, arpra_neg, arpra_sqrt, arpra_exp, arpra_log, arpra_inv
+};
+static const test_mpfi_fn_1 mpfi_fn_1[TEST_UNIVARIATE_OPS] =
+{
+    mpfi_set, mpfi_neg, mpfi_sqrt, mpfi_exp, mpfi_log, mpfi_inv
+};
+static const test_fn_2 fn_2[TEST_OPS - TEST_UNIVARIATE_OPS] =
+{
+    arpra_add, arpra_sub, arpra_mul, arpra_div
+};
+static const test_mpfi_fn_2 mpfi_fn_2[TEST_OPS - TEST_UNIVARIATE_OPS] =
+{
+    mpfi_add, mpfi_sub, mpfi_mul, mpfi_div
+};
+
+// Compute y = op(x1_A, x2_A) with Arpra.
+static void test_op (arpra_range *y, arpra_uint op)
+{
+    if (op < TEST_UNIVARIATE_OPS) {
+        fn_1[op](y, &x1_A);
+    }
+    else {
+        fn_2[op - TEST_UNIVARIATE_OPS](y, &x1_A, &x2_A);
+    }
+}
+
+int main (int argc, char *argv[])
+{
+    const arpra_prec prec = 24;
+    const arpra_prec prec_internal = 256;
+    const arpra_uint test_n = 100000;
+    const char *names[TEST_OPS] =
+    {
+        "set", "neg", "sqrt", "exp", "log", "inv", "add", "sub", "mul", "div"
+    };
+    const char *selections[TEST_SELECTIONS] =
+    {
+        "global IA", "local IA", "local affine"
+    };
+    const arpra_range_method affine[3] =
+    {
+        ARPRA_AA, ARPRA_MIXED_IAAA, ARPRA_MIXED_TRIMMED_IAAA
+    };
+    arpra_range z_A;
+    arpra_range_method method;
+    arpra_uint i, op, selection, fail, fail_n;
+
+    // Init test.
+    test_fixture_init(prec, prec_internal);
+    test_log_init("range_method");
+    test_rand_init();
+    arpra_init2(&z_A, prec);
+    fail_n = 0;
+
+    // Run test.
+    for (i = 0; i < test_n; i++) {
+        fail = 0;
+        op = gmp_urandomm_ui(test_randstate, TEST_OPS);
+        selection = gmp_urandomm_ui(test_randstate, TEST_SELECTIONS);
+        method = affine[gmp_urandomm_ui(test_randstate, 3)];
+
+        // Logarithms and square roots of negative numbers are NaN.
+        if ((op == 2) || (op == 4)) {
+            test_rand_arpra(&x1_A, TEST_RAND_POS, TEST_RAND_SMALL);
+        }
+        else {
+            test_rand_arpra(&x1_A, TEST_RAND_MIXED, TEST_RAND_SMALL);
+        }
+        test_rand_arpra(&x2_A, TEST_RAND_MIXED, TEST_RAND_SMALL);
+
+        test_log_printf("Test %lu: %s, %s.\n", i, names[op], selections[selection]);
+        test_log_mpfi(&(x1_A.true_range), "x1_A");
+        test_log_mpfi(&(x2_A.true_range), "x2_A");
+
+        // Compute y with MPFI.
+        if (op < TEST_UNIVARIATE_OPS) {
+            mpfi_fn_1[op](y_I, &(x1_A.true_range));
+        }
+        else {
+            mpfi_fn_2[op - TEST_UNIVARIATE_OPS](y_I, &(x1_A.true_range), &(x2_A.true_range));
+        }
+        test_log_mpfi(y_I, "y_I");
+
+        // Pass criteria:
+        if (selection < 2) {
+            // Select the IA method for y, either globally or for y alone.
+            if (selection == 0) {
+                arpra_set_range_method(ARPRA_IA);
+            }
+            else {
+                arpra_set_range_method(method);
+                arpra_set_local_range_method(&y_A, ARPRA_IA);
+            }
+            test_op(&y_A, op);
+            test_log_mpfi(&(y_A.true_range), "y_A");
+
+            // 1) y is the MPFI result, or is unbounded with it.
+            if (mpfi_bounded_p(y_I)) {
+                if (!mpfr_equal_p(&(y_A.true_range.left), &(y_I->left))
+                        || !mpfr_equal_p(&(y_A.true_range.right), &(y_I->right))) {
+                    test_log_printf("MPFI range: FAIL\n");
+                    fail = 1;
+                }
+
+                // 2) y has a single deviation term.
+                if (y_A.nTerms != 1) {
+                    test_log_printf("Term count: FAIL\n");
+                    fail = 1;
+                }
+            }
+            else if (arpra_bounded_p(&y_A)) {
+                test_log_printf("Unbounded range: FAIL\n");
+                fail = 1;
+            }
+        }
+        else {
+            // Select an affine method for y alone, and compare it with the
+            // same method selected globally.
+            arpra_set_range_method(method);
+            test_op(&z_A, op);
+            arpra_set_range_method(ARPRA_IA);
+            arpra_set_local_range_method(&y_A, method);
+            test_op(&y_A, op);
+            test_log_mpfi(&(y_A.true_range), "y_A");
+            test_log_mpfi(&(z_A.true_range), "z_A");
+
+            // 3) y is the range computed by the global affine method.
+            if (!((mpfr_equal_p(&(y_A.true_range.left), &(z_A.true_range.left))
+                   && mpfr_equal_p(&(y_A.true_range.right), &(z_A.true_range.right)))
+                  || (arpra_nan_p(&y_A) && arpra_nan_p(&z_A)))) {
+                test_log_printf("Local method: FAIL\n");
+                fail = 1;
+            }
+        }
+
+        // 4) y keeps its own method.
+        if (arpra_get_local_range_method(&y_A) != ((selection == 0) ? ARPRA_GLOBAL_RANGE_METHOD
+                                                    : (selection == 1) ? ARPRA_IA : method)) {
+            test_log_printf("Method kept: FAIL\n");
+            fail = 1;
+        }
+        arpra_set_local_range_method(&y_A, ARPRA_GLOBAL_RANGE_METHOD);
+
+        test_log_printf("Result: %s\n\n", fail ? "FAIL" : "PASS");
+        if (fail) fail_n++;
+    }
+
+    // Cleanup test.
+    printf("%lu out of %lu failed.\n", fail_n, test_n);
+    arpra_set_range_method(ARPRA_DEFAULT_RANGE_METHOD);
+    arpra_clear(&z_A);
+    test_fixture_clear();
+    test_log_clear();
+    test_rand_clear();
+    return fail_n > 0;
+}
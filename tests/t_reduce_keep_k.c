@@ -0,0 +1,154 @@
+/*
+ * t_reduce_keep_k.c -- Test the arpra_reduce_keep_k function.
+ *
+ * Copyright 2017-2020 James Paul Turner.
+ *
+ * This file is part of the Arpra library.
+ *
+ * The Arpra library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Arpra library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with the Arpra library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "arpra-test.h"
+
+// Is the symbol of term i of x1 also in y, not counting its new error term?
+static int test_kept (const arpra_range *y, const arpra_range *x1, arpra_uint i)
+{
+    arpra_uint i_y;
+
+    for (i_y = 0; (i_y + 1) < y->nTerms; i_y++) {
+        if (y->symbols[i_y] == x1->symbols[i]) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// Recompute the radius and true_range of x1 after editing its terms.
+static void test_refresh (arpra_range *x1)
+{
+    arpra_uint i_x1;
+
+    mpfr_set_zero(&(x1->radius), 1);
+    for (i_x1 = 0; i_x1 < x1->nTerms; i_x1++) {
+        ARPRA_RADIUS_ADD(&(x1->radius), &(x1->deviations[i_x1]));
+    }
+    arpra_helper_compute_range(x1);
+}
+
+int main (int argc, char *argv[])
+{
+    const arpra_prec prec = 24;
+    const arpra_prec prec_internal = 256;
+    const arpra_uint test_n = 100000;
+    const unsigned int protect_mask = 0xF & ~(1U << ARPRA_SYMBOL_PARAMETER);
+    arpra_uint i, j, i_x1, k, n_protected, fail, fail_n;
+    unsigned int classes;
+
+    // Init test.
+    test_fixture_init(prec, prec_internal);
+    test_log_init("reduce_keep_k");
+    test_rand_init();
+    fail_n = 0;
+
+    // Run test.
+    for (i = 0; i < test_n; i++) {
+        fail = 0;
+        test_rand_uniform_arpra(&x1_A, -10, 10, 1, 4);
+        k = gmp_urandomm_ui(test_randstate, 11);
+
+        // Give some terms equal magnitudes, to exercise tie-breaking.
+        for (j = 1; j < x1_A.nTerms; j++) {
+            if (gmp_urandomm_ui(test_randstate, 3) == 0) {
+                mpfr_set(&(x1_A.deviations[j]), &(x1_A.deviations[j - 1]), MPFR_RNDN);
+            }
+        }
+
+        // Protect parameter terms on every other iteration.
+        classes = (i % 2) ? protect_mask : 0xF;
+        arpra_set_reduce_classes(classes);
+        for (j = 0; j < x1_A.nTerms; j++) {
+            if (gmp_urandomm_ui(test_randstate, 4) == 0) {
+                x1_A.symbols[j] = (x1_A.symbols[j] & ~ARPRA_SYMBOL_CLASS_MASK)
+                    | ARPRA_SYMBOL_PARAMETER;
+            }
+        }
+        test_refresh(&x1_A);
+        for (j = 0, n_protected = 0; j < x1_A.nTerms; j++) {
+            n_protected += !((classes >> ARPRA_SYMBOL_CLASS(x1_A.symbols[j])) & 1);
+        }
+
+        test_log_printf("Test %lu: %lu terms, k = %lu, %lu protected.\n",
+                        i, x1_A.nTerms, k, n_protected);
+        test_log_mpfi(&(x1_A.true_range), "x1_A");
+
+        arpra_reduce_keep_k(&y_A, &x1_A, k);
+        test_log_mpfi(&(y_A.true_range), "y_A");
+
+        // Pass criteria:
+        // 1) Arpra y contains Arpra x1.
+        if (mpfr_greater_p(&(y_A.true_range.left), &(x1_A.true_range.left))
+                || mpfr_less_p(&(y_A.true_range.right), &(x1_A.true_range.right))) {
+            test_log_printf("Enclosure: FAIL\n");
+            fail = 1;
+        }
+
+        // 2) y has k terms plus protected terms plus one error term, or the
+        //    terms of x1 if it has no more terms than that.
+        if (x1_A.nTerms > (k + n_protected)) {
+            if (y_A.nTerms != (k + n_protected + 1)) {
+                test_log_printf("Term count: FAIL\n");
+                fail = 1;
+            }
+        }
+        else if (y_A.nTerms != x1_A.nTerms) {
+            test_log_printf("Term count: FAIL\n");
+            fail = 1;
+        }
+
+        if (x1_A.nTerms > (k + n_protected)) {
+            for (j = 0; j < x1_A.nTerms; j++) {
+                // 3) Every protected term of x1 is kept.
+                if (!((classes >> ARPRA_SYMBOL_CLASS(x1_A.symbols[j])) & 1)) {
+                    if (!test_kept(&y_A, &x1_A, j)) {
+                        test_log_printf("Protected term %lu: FAIL\n", j);
+                        fail = 1;
+                    }
+                }
+
+                // 4) No condensed term is larger than a kept reducible term.
+                else if (!test_kept(&y_A, &x1_A, j)) {
+                    for (i_x1 = 0; i_x1 < x1_A.nTerms; i_x1++) {
+                        if (((classes >> ARPRA_SYMBOL_CLASS(x1_A.symbols[i_x1])) & 1)
+                                && test_kept(&y_A, &x1_A, i_x1)
+                                && (mpfr_cmpabs(&(x1_A.deviations[j]), &(x1_A.deviations[i_x1])) > 0)) {
+                            test_log_printf("Condensed term %lu: FAIL\n", j);
+                            fail = 1;
+                        }
+                    }
+                }
+            }
+        }
+
+        test_log_printf("Result: %s\n\n", fail ? "FAIL" : "PASS");
+        if (fail) fail_n++;
+    }
+
+    // Cleanup test.
+    printf("%lu out of %lu failed.\n", fail_n, test_n);
+    arpra_set_reduce_classes(0xF);
+    test_fixture_clear();
+    test_log_clear();
+    test_rand_clear();
+    return fail_n > 0;
+}
@@ -0,0 +1,155 @@
+/*
+ * t_reduce_vector.c -- Test the arpra_reduce_vector function.
+ *
+ * Copyright 2017-2020 James Paul Turner.
+ *
+ * This file is part of the Arpra library.
+ *
+ * The Arpra library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Arpra library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with the Arpra library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "arpra-test.h"
+
+#define TEST_DIMS 3
+
+// Does symbol s appear in any of the n ranges in x?
+static int test_has_symbol (const arpra_range *x, arpra_uint n, arpra_symbol s)
+{
+    arpra_uint i, i_x;
+
+    for (i = 0; i < n; i++) {
+        for (i_x = 0; i_x < x[i].nTerms; i_x++) {
+            if (x[i].symbols[i_x] == s) {
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+int main (int argc, char *argv[])
+{
+    const arpra_prec prec = 24;
+    const arpra_prec prec_internal = 256;
+    const arpra_uint test_n = 20000;
+    const char *names[2] = {"BOX", "PCA"};
+    arpra_range x[TEST_DIMS], y[TEST_DIMS], z[TEST_DIMS];
+    arpra_uint i, j, i_x, k, n_kept, degenerate, fail, fail_n;
+    arpra_reduce_method method;
+
+    // Init test.
+    test_fixture_init(prec, prec_internal);
+    test_log_init("reduce_vector");
+    test_rand_init();
+    for (j = 0; j < TEST_DIMS; j++) {
+        arpra_init2(&x[j], prec);
+        arpra_init2(&y[j], prec);
+        arpra_init2(&z[j], prec);
+    }
+    fail_n = 0;
+
+    // Run test.
+    for (i = 0; i < test_n; i++) {
+        fail = 0;
+        method = (i % 2) ? ARPRA_REDUCE_PCA : ARPRA_REDUCE_BOX;
+        degenerate = ((i / 2) % 4) == 0;
+        k = gmp_urandomm_ui(test_randstate, 7);
+        arpra_set_reduce_method(method);
+
+        // Either x = (x0, 2 x0, -x0), whose generators have rank one, or
+        // x = (x0, x1, x0 + x1) with some symbols shared by x0 and x1.
+        test_rand_uniform_arpra(&x[0], -10, 10, -4, 4);
+        if (degenerate) {
+            arpra_add(&x[1], &x[0], &x[0]);
+            arpra_neg(&x[2], &x[0]);
+        }
+        else {
+            test_rand_uniform_arpra(&x[1], -10, 10, -4, 4);
+            test_share_rand_syms(&x[0], &x[1]);
+            arpra_add(&x[2], &x[0], &x[1]);
+        }
+
+        test_log_printf("Test %lu: %s, k = %lu%s.\n",
+                        i, names[method], k, degenerate ? ", degenerate" : "");
+        for (j = 0; j < TEST_DIMS; j++) {
+            test_log_mpfi(&(x[j].true_range), "x");
+        }
+
+        arpra_reduce_vector(y, x, TEST_DIMS, k);
+        for (j = 0; j < TEST_DIMS; j++) {
+            test_log_mpfi(&(y[j].true_range), "y");
+        }
+
+        // Pass criteria:
+        for (j = 0; j < TEST_DIMS; j++) {
+            // 1) Arpra y[j] contains Arpra x[j].
+            if (arpra_nan_p(&(y[j]))
+                    || mpfr_greater_p(&(y[j].true_range.left), &(x[j].true_range.left))
+                    || mpfr_less_p(&(y[j].true_range.right), &(x[j].true_range.right))) {
+                test_log_printf("Enclosure %lu: FAIL\n", j);
+                fail = 1;
+            }
+
+            // 2) y[j] has at most k terms of x, one shared term per
+            //    dimension, and one error term.
+            if (y[j].nTerms > (k + TEST_DIMS + 1)) {
+                test_log_printf("Term count %lu: FAIL\n", j);
+                fail = 1;
+            }
+        }
+
+        // 3) At most k distinct symbols of x are kept in y.
+        for (j = 0, n_kept = 0; j < TEST_DIMS; j++) {
+            for (i_x = 0; i_x < x[j].nTerms; i_x++) {
+                if (!test_has_symbol(x, j, x[j].symbols[i_x])
+                        && test_has_symbol(y, TEST_DIMS, x[j].symbols[i_x])) {
+                    n_kept++;
+                }
+            }
+        }
+        if (n_kept > k) {
+            test_log_printf("Kept symbols: FAIL\n");
+            fail = 1;
+        }
+
+        // 4) Reducing in place gives the same ranges.
+        for (j = 0; j < TEST_DIMS; j++) {
+            arpra_set(&z[j], &x[j]);
+        }
+        arpra_reduce_vector(z, z, TEST_DIMS, k);
+        for (j = 0; j < TEST_DIMS; j++) {
+            if (!mpfr_equal_p(&(z[j].true_range.left), &(y[j].true_range.left))
+                    || !mpfr_equal_p(&(z[j].true_range.right), &(y[j].true_range.right))) {
+                test_log_printf("In place %lu: FAIL\n", j);
+                fail = 1;
+            }
+        }
+
+        test_log_printf("Result: %s\n\n", fail ? "FAIL" : "PASS");
+        if (fail) fail_n++;
+    }
+
+    // Cleanup test.
+    printf("%lu out of %lu failed.\n", fail_n, test_n);
+    arpra_set_reduce_method(ARPRA_DEFAULT_REDUCE_METHOD);
+    for (j = 0; j < TEST_DIMS; j++) {
+        arpra_clear(&x[j]);
+        arpra_clear(&y[j]);
+        arpra_clear(&z[j]);
+    }
+    test_fixture_clear();
+    test_log_clear();
+    test_rand_clear();
+    return fail_n > 0;
+}
@@ -0,0 +1,164 @@
+/*
+ * t_share.c -- Test that ranges sharing deviation terms copy on write.
+ *
+ * Copyright 2017-2020 James Paul Turner.
+ *
+ * This file is part of the Arpra library.
+ *
+ * The Arpra library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Arpra library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with the Arpra library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "arpra-test.h"
+
+#define TEST_OPS 7
+
+// Copy x1 to y without sharing its terms.
+static void test_copy (arpra_range *y, const arpra_range *x1)
+{
+    arpra_uint i;
+
+    arpra_clear(y);
+    arpra_init2(y, x1->precision);
+    mpfr_set_prec(&(y->centre), mpfr_get_prec(&(x1->centre)));
+    mpfr_set_prec(&(y->radius), mpfr_get_prec(&(x1->radius)));
+    mpfr_set(&(y->centre), &(x1->centre), MPFR_RNDN);
+    mpfr_set(&(y->radius), &(x1->radius), MPFR_RNDN);
+    mpfi_set(&(y->true_range), &(x1->true_range));
+    arpra_helper_alloc_terms(y, x1->nTerms);
+    for (i = 0; i < x1->nTerms; i++) {
+        mpfr_init2(&(y->deviations[i]), mpfr_get_prec(&(x1->deviations[i])));
+        mpfr_set(&(y->deviations[i]), &(x1->deviations[i]), MPFR_RNDN);
+        y->symbols[i] = x1->symbols[i];
+    }
+    y->nTerms = x1->nTerms;
+}
+
+int main (int argc, char *argv[])
+{
+    const arpra_prec prec = 24;
+    const arpra_prec prec_internal = 256;
+    const arpra_uint test_n = 100000;
+    const char *names[TEST_OPS] =
+    {
+        "set_precision", "add", "increase", "renumber_symbols",
+        "reduce_keep_k", "swap", "move"
+    };
+    arpra_range x1_C, z_A, w_A;
+    arpra_range *renumber[1];
+    mpfr_t delta;
+    arpra_uint i, op, fail, fail_n;
+    int share_z;
+
+    // Init test.
+    test_fixture_init(prec, prec_internal);
+    test_log_init("share");
+    test_rand_init();
+    arpra_init2(&x1_C, prec);
+    arpra_init2(&z_A, prec);
+    arpra_init3(&w_A, prec, prec_internal / 4);
+    mpfr_init2(delta, prec);
+    fail_n = 0;
+
+    // Run test.
+    for (i = 0; i < test_n; i++) {
+        fail = 0;
+        op = gmp_urandomm_ui(test_randstate, TEST_OPS);
+        share_z = gmp_urandomb_ui(test_randstate, 1);
+
+        // y and possibly z share the terms of x1.
+        test_rand_arpra(&x1_A, TEST_RAND_MIXED, TEST_RAND_SMALL);
+        test_rand_arpra(&x2_A, TEST_RAND_MIXED, TEST_RAND_SMALL);
+        test_copy(&x1_C, &x1_A);
+        arpra_set(&y_A, &x1_A);
+        if (share_z) {
+            arpra_set(&z_A, &y_A);
+        }
+        arpra_set(&w_A, &x1_A);
+
+        test_log_printf("Test %lu: %s%s.\n", i, names[op], share_z ? ", shared twice" : "");
+        test_log_mpfi(&(x1_A.true_range), "x1_A");
+
+        // Pass criteria:
+        // 1) Setting a range at the same precision shares the terms.
+        if (arpra_bounded_p(&x1_A) && (y_A.deviations != x1_A.deviations)) {
+            test_log_printf("Sharing: FAIL\n");
+            fail = 1;
+        }
+
+        // 2) Setting a range at a lower internal precision rounds the terms.
+        if ((x1_A.nTerms > 0) && (w_A.deviations == x1_A.deviations)) {
+            test_log_printf("Internal precision: FAIL\n");
+            fail = 1;
+        }
+        if (arpra_bounded_p(&w_A) && (mpfr_get_prec(&(w_A.centre)) > (prec_internal / 4))) {
+            test_log_printf("Internal precision: FAIL\n");
+            fail = 1;
+        }
+
+        // Write to y.
+        switch (op) {
+        case 0:
+            arpra_set_precision(&y_A, prec / 2);
+            arpra_set_precision(&y_A, prec);
+            break;
+        case 1:
+            arpra_add(&y_A, &y_A, &x2_A);
+            break;
+        case 2:
+            test_rand_mpfr(delta, prec, TEST_RAND_SMALL_POS);
+            arpra_increase(&y_A, &y_A, delta);
+            break;
+        case 3:
+            renumber[0] = &y_A;
+            arpra_renumber_symbols(renumber, 1);
+            break;
+        case 4:
+            arpra_reduce_keep_k(&y_A, &y_A, gmp_urandomm_ui(test_randstate, 4));
+            break;
+        case 5:
+            arpra_swap(&y_A, &x2_A);
+            arpra_neg(&x2_A, &x2_A);
+            break;
+        case 6:
+            arpra_move(&x2_A, &y_A);
+            arpra_exp(&x2_A, &x2_A);
+            break;
+        }
+        test_log_mpfi(&(y_A.true_range), "y_A");
+
+        // 3) The ranges still sharing the old terms are unchanged.
+        if (test_compare_arpra(&x1_A, &x1_C)) {
+            test_log_printf("x1_A unchanged: FAIL\n");
+            fail = 1;
+        }
+        if (share_z && test_compare_arpra(&z_A, &x1_C)) {
+            test_log_printf("z_A unchanged: FAIL\n");
+            fail = 1;
+        }
+
+        test_log_printf("Result: %s\n\n", fail ? "FAIL" : "PASS");
+        if (fail) fail_n++;
+    }
+
+    // Cleanup test.
+    printf("%lu out of %lu failed.\n", fail_n, test_n);
+    arpra_clear(&x1_C);
+    arpra_clear(&z_A);
+    arpra_clear(&w_A);
+    mpfr_clear(delta);
+    test_fixture_clear();
+    test_log_clear();
+    test_rand_clear();
+    return fail_n > 0;
+}
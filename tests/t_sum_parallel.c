@@ -0,0 +1,190 @@
+/*
+ * t_sum_parallel.c -- Test the arpra_sum_parallel function.
+ *
+ * Copyright 2017-2020 James Paul Turner.
+ *
+ * This file is part of the Arpra library.
+ *
+ * The Arpra library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Arpra library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with the Arpra library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "arpra-test.h"
+
+#define TEST_MAX_N 64
+
+// Is the exact sum of the n ranges in x within y? Every symbol of x must be
+// in y, and the differences between the exact sums of x and the terms of y
+// must be covered by the terms of y with new symbols, above x_max.
+static int test_sound (const arpra_range *y, const arpra_range *x, arpra_uint n,
+                       arpra_symbol x_max)
+{
+    const arpra_prec prec_exact = 4096;
+    mpfr_t slack, budget, temp;
+    mpfr_ptr exact;
+    arpra_uint i, i_x, i_y, lo, hi;
+    int sound;
+
+    // Initialise vars.
+    mpfr_init2(slack, prec_exact);
+    mpfr_init2(budget, prec_exact);
+    mpfr_init2(temp, prec_exact);
+    exact = malloc(y->nTerms * sizeof(mpfr_t));
+    for (i_y = 0; i_y < y->nTerms; i_y++) {
+        mpfr_init2(&(exact[i_y]), prec_exact);
+        mpfr_set_zero(&(exact[i_y]), 1);
+    }
+    sound = 1;
+
+    // slack = |x1[0] + ... + xn[0] - y[0]|
+    mpfr_neg(slack, &(y->centre), MPFR_RNDN);
+    for (i = 0; i < n; i++) {
+        mpfr_add(slack, slack, &(x[i].centre), MPFR_RNDN);
+    }
+    mpfr_abs(slack, slack, MPFR_RNDN);
+
+    // exact[j] = x1[j] + ... + xn[j]
+    for (i = 0; i < n; i++) {
+        for (i_x = 0; i_x < x[i].nTerms; i_x++) {
+            for (lo = 0, hi = y->nTerms - 1; lo < hi; ) {
+                if (y->symbols[(lo + hi) / 2] < x[i].symbols[i_x]) {
+                    lo = ((lo + hi) / 2) + 1;
+                }
+                else {
+                    hi = (lo + hi) / 2;
+                }
+            }
+            if (y->symbols[lo] != x[i].symbols[i_x]) {
+                sound = 0;
+            }
+            mpfr_add(&(exact[lo]), &(exact[lo]), &(x[i].deviations[i_x]), MPFR_RNDN);
+        }
+    }
+
+    // slack += |exact[j] - y[j]|, or budget += |y[j]| for new symbols.
+    mpfr_set_zero(budget, 1);
+    for (i_y = 0; i_y < y->nTerms; i_y++) {
+        if (y->symbols[i_y] > x_max) {
+            mpfr_abs(temp, &(y->deviations[i_y]), MPFR_RNDN);
+            mpfr_add(budget, budget, temp, MPFR_RNDN);
+        }
+        else {
+            mpfr_sub(temp, &(exact[i_y]), &(y->deviations[i_y]), MPFR_RNDN);
+            mpfr_abs(temp, temp, MPFR_RNDN);
+            mpfr_add(slack, slack, temp, MPFR_RNDN);
+        }
+    }
+    if (mpfr_greater_p(slack, budget)) {
+        sound = 0;
+    }
+
+    // Clear vars.
+    mpfr_clear(slack);
+    mpfr_clear(budget);
+    mpfr_clear(temp);
+    for (i_y = 0; i_y < y->nTerms; i_y++) {
+        mpfr_clear(&(exact[i_y]));
+    }
+    free(exact);
+
+    return sound;
+}
+
+int main (int argc, char *argv[])
+{
+    // Ranges have the internal precision, so that rounding true_range does
+    // not hide rounding errors in the sum.
+    const arpra_prec prec = 256;
+    const arpra_prec prec_internal = 256;
+    const arpra_uint test_n = 10000;
+    arpra_range x[TEST_MAX_N];
+    arpra_symbol x_max;
+    arpra_uint i, j, n, threads, fail, fail_n;
+
+    // Init test.
+    test_fixture_init(prec, prec_internal);
+    test_log_init("sum_parallel");
+    test_rand_init();
+    for (j = 0; j < TEST_MAX_N; j++) {
+        arpra_init2(&x[j], prec);
+    }
+    fail_n = 0;
+
+    // Run test.
+    for (i = 0; i < test_n; i++) {
+        fail = 0;
+
+        // Sums of two ranges are done by arpra_add, so start at three.
+        n = 3 + gmp_urandomm_ui(test_randstate, TEST_MAX_N - 2);
+        threads = 2 + gmp_urandomm_ui(test_randstate, 3);
+        arpra_set_threads(threads);
+
+        // Random ranges, some of which share symbols with the one before.
+        for (j = 0; j < n; j++) {
+            test_rand_uniform_arpra(&x[j], -10, 10, -1, 1);
+            if ((j > 0) && gmp_urandomb_ui(test_randstate, 1)) {
+                test_share_rand_syms(&x[j - 1], &x[j]);
+            }
+        }
+        x_max = arpra_helper_next_symbol(ARPRA_SYMBOL_ROUNDING);
+
+        test_log_printf("Test %lu: %lu ranges, %lu threads.\n", i, n, threads);
+
+        arpra_sum(&x1_A, x, n);
+        arpra_sum_parallel(&y_A, x, n);
+        test_log_mpfi(&(x1_A.true_range), "x1_A");
+        test_log_mpfi(&(y_A.true_range), "y_A");
+
+        // Pass criteria:
+        // 1) y and the serial sum both enclose the exact sum. The partial
+        //    sums round differently, so y need not contain the serial sum.
+        if (!test_sound(&y_A, x, n, x_max)) {
+            test_log_printf("Soundness: FAIL\n");
+            fail = 1;
+        }
+        if (!test_sound(&x1_A, x, n, x_max)) {
+            test_log_printf("Serial soundness: FAIL\n");
+            fail = 1;
+        }
+
+        // 2) y has the same symbols as the serial sum, except new ones.
+        if (y_A.nTerms != x1_A.nTerms) {
+            test_log_printf("Term count: FAIL\n");
+            fail = 1;
+        }
+        else {
+            for (j = 0; j < y_A.nTerms; j++) {
+                if ((y_A.symbols[j] != x1_A.symbols[j])
+                        && ((y_A.symbols[j] <= x_max) || (x1_A.symbols[j] <= x_max))) {
+                    test_log_printf("Symbol %lu: FAIL\n", j);
+                    fail = 1;
+                }
+            }
+        }
+
+        test_log_printf("Result: %s\n\n", fail ? "FAIL" : "PASS");
+        if (fail) fail_n++;
+    }
+
+    // Cleanup test.
+    printf("%lu out of %lu failed.\n", fail_n, test_n);
+    arpra_set_threads(1);
+    for (j = 0; j < TEST_MAX_N; j++) {
+        arpra_clear(&x[j]);
+    }
+    arpra_clear_buffers();
+    test_fixture_clear();
+    test_log_clear();
+    test_rand_clear();
+    return fail_n > 0;
+}